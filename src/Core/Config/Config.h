@@ -16,6 +16,7 @@
 #include "ConfigItem.hxx"
 #include "Core/MultinomialDistributionGenerator.h"
 #include "Core/PropertyMacro.h"
+#include "Core/RelativeInfectivity.hxx"
 #include "Core/TypeDef.h"
 #include "CustomConfigItem.h"
 #include "PreconfigEvents.hxx"
@@ -33,7 +34,21 @@ public:
   std::vector<IConfigItem*> config_items{};
 
   CONFIG_ITEM(days_between_notifications, int, 100)
+
+  // Defer the periodic updates of the individuals while no parasites are
+  // present and none can be introduced
+  CONFIG_ITEM(fast_forward_without_parasites, bool, false)
   CONFIG_ITEM(initial_seed_number, unsigned long, 0)
+
+  // Use the single Mersenne Twister stream from prior versions for the main
+  // stream instead of the counter-based generator, note that the substreams
+  // are still counter based so prior results are not reproduced
+  CONFIG_ITEM(legacy_random_number_generator, bool, false)
+
+  // Number of threads used for the parallel phases of the time step, the
+  // results do not depend upon the number of threads
+  CONFIG_ITEM(number_of_threads, int, 1)
+
   CONFIG_ITEM(connection_string, std::string, "")
   CONFIG_ITEM(record_genome_db, bool, false)
 
@@ -69,6 +84,10 @@ public:
 
   CONFIG_ITEM(using_free_recombination, bool, true)
 
+  // Draw the gap between drug induced mutations instead of rolling for each
+  // parasite clone and drug, note this changes the random number stream
+  CONFIG_ITEM(aggregate_mutation_sampling, bool, false)
+
   CONFIG_ITEM(using_age_dependent_bitting_level, bool, false)
 
   CONFIG_ITEM(fraction_mosquitoes_interrupted_feeding, double, 0.0)
@@ -116,7 +135,7 @@ public:
 
   CUSTOM_CONFIG_ITEM(number_of_locations, 0)
 
-  CUSTOM_CONFIG_ITEM(spatial_distance_matrix, DoubleVector2())
+  CUSTOM_CONFIG_ITEM(spatial_distance_matrix, Spatial::DistanceMatrix())
 
   CUSTOM_CONFIG_ITEM(seasonal_info, nullptr)
 
@@ -23,6 +23,7 @@
 #include "GIS/SpatialData.h"
 #include "Helpers/NumberHelpers.hxx"
 #include "Helpers/ObjectHelpers.h"
+#include "Population/DrugsInBlood.h"
 #include "Spatial/SpatialModelBuilder.hxx"
 #include "Strategies/IStrategy.h"
 #include "Strategies/StrategyBuilder.h"
@@ -53,19 +54,7 @@ void spatial_distance_matrix::set_value(const YAML::Node &node) {
   }
 
   VLOG(1) << "Generating Euclidian distances using coordinates provided";
-  value_.resize(static_cast<unsigned long>(config_->number_of_locations()));
-  for (auto from_location = 0ul; from_location < config_->number_of_locations();
-       from_location++) {
-    value_[from_location].resize(
-        static_cast<unsigned long long int>(config_->number_of_locations()));
-    for (auto to_location = 0ul; to_location < config_->number_of_locations();
-         to_location++) {
-      value_[from_location][to_location] =
-          Spatial::Coordinate::calculate_distance_in_km(
-              *config_->location_db()[from_location].coordinate,
-              *config_->location_db()[to_location].coordinate);
-    }
-  }
+  value_ = Spatial::DistanceMatrix::from_coordinates(config_->location_db());
 }
 
 seasonal_info::~seasonal_info() {
@@ -156,6 +145,21 @@ void immune_system_information::set_value(const YAML::Node &node) {
   }
   assert(value_.acquire_rate_by_age.size() == 81);
 
+  // Precompute the immune response terms now that the rates are known
+  value_.acquire_by_age.clear();
+  for (auto rate : value_.acquire_rate_by_age) {
+    value_.acquire_by_age.emplace_back(rate);
+  }
+  value_.decay = ExponentialDecayTable(value_.decay_rate);
+
+  const auto max_probability = value_.max_clinical_probability;
+  const auto midpoint = value_.midpoint;
+  const auto slope = value_.immune_effect_on_progression_to_clinical;
+  value_.clinical_progression = InterpolationTable(
+      0.0, 1.0, CLINICAL_PROGRESSION_INTERVALS, [&](double immune) {
+        return max_probability / (1 + pow((immune / midpoint), slope));
+      });
+
   value_.c_min = pow(
       10, -(config_->parasite_density_level().log_parasite_density_asymptomatic
             - config_->parasite_density_level().log_parasite_density_cured)
@@ -181,18 +185,8 @@ void genotype_db::set_value(const YAML::Node &node) {
     temp *= (int)config_->genotype_info().loci_vector[i + 1].alleles.size();
     value_->weight()[i] = temp;
   }
-  auto number_of_genotypes = 1;
-  for (auto &locus : config_->genotype_info().loci_vector) {
-    number_of_genotypes *= (int)locus.alleles.size();
-  }
 
-  for (auto i = 0; i < number_of_genotypes; i++) {
-    auto* int_genotype =
-        new Genotype(i, config_->genotype_info(), value_->weight());
-    value_->add(int_genotype);
-  }
-
-  value_->initialize_matting_matrix();
+  value_->build(config_->genotype_info());
 }
 
 void number_of_parasite_types::set_value(const YAML::Node &node) {
@@ -205,6 +199,13 @@ void drug_db::set_value(const YAML::Node &node) {
   ObjectHelpers::delete_pointer<DrugDatabase>(value_);
   value_ = new DrugDatabase();
 
+  // The drugs in the blood are held in fixed slots indexed by the drug id
+  if (static_cast<int>(node[name_].size()) > DrugsInBlood::MAX_DRUG_TYPES) {
+    throw std::invalid_argument(
+        fmt::format("At most {} drugs may be defined in the drug_db, found {}",
+                    DrugsInBlood::MAX_DRUG_TYPES, node[name_].size()));
+  }
+
   for (unsigned int drug_id = 0; drug_id < node[name_].size(); drug_id++) {
     auto* dt = new DrugType();
     dt->set_id(drug_id);
@@ -254,6 +255,8 @@ void drug_db::set_value(const YAML::Node &node) {
 
     dt->set_k(dt_node["k"].as<double>());
 
+    dt->build_decay_table();
+
     value_->add(dt);
   }
 }
@@ -275,6 +278,11 @@ void EC50_power_n_table::set_value(const YAML::Node &node) {
       value_[g_id][i] = pow(value_[g_id][i], config_->drug_db()->at(i)->n());
     }
   }
+
+  // Build the killing rate lookup tables now that EC50^n is known
+  for (auto &drug : *config_->drug_db()) {
+    drug.second->build_killing_rate_tables(value_);
+  }
 }
 
 void circulation_info::set_value(const YAML::Node &node) {
@@ -17,6 +17,7 @@
 #include "Core/MultinomialDistributionGenerator.h"
 #include "Environment/SeasonalInfo.h"
 #include "Parasites/GenotypeDatabase.h"
+#include "Spatial/DistanceMatrix.h"
 #include "Therapies/DrugDatabase.h"
 
 namespace YAML {
@@ -55,14 +56,19 @@ public:
   void set_value(const YAML::Node &node) override;
 };
 
-class spatial_distance_matrix
-    : public ConfigItem<std::vector<std::vector<double>>> {
+class spatial_distance_matrix : public IConfigItem {
+  DELETE_COPY_AND_MOVE(spatial_distance_matrix)
+
+public:
+  Spatial::DistanceMatrix value_;
+
 public:
   spatial_distance_matrix(const std::string &name,
-                          const std::vector<std::vector<double>> &default_value,
+                          Spatial::DistanceMatrix default_value,
                           Config* config)
-      : ConfigItem<std::vector<std::vector<double>>>(name, default_value,
-                                                     config) {}
+      : IConfigItem(config, name), value_{std::move(default_value)} {}
+
+  virtual Spatial::DistanceMatrix &operator()() { return value_; }
 
   void set_value(const YAML::Node &node) override;
 };
@@ -116,6 +122,10 @@ class immune_system_information : public IConfigItem {
   DELETE_COPY_AND_MOVE(immune_system_information)
 
 public:
+  // Number of intervals over the immune level [0, 1] for the clinical
+  // progression table, the linear interpolation error is below 1e-5
+  static constexpr int CLINICAL_PROGRESSION_INTERVALS = 2048;
+
   ImmuneSystemInformation value_;
 
 public:
@@ -12,6 +12,7 @@
 
 #include <cmath>
 
+#include "Core/RelativeInfectivity.hxx"
 #include "Core/TypeDef.h"
 #include "GIS/SpatialData.h"
 #include "Spatial/Location.h"
@@ -255,6 +256,7 @@ struct convert<RelativeInfectivity> {
         (log(ro) - log(d_star)) / relative_infectivity.sigma;
 
     relative_infectivity.sigma = log(10) / relative_infectivity.sigma;
+    relative_infectivity.build_curve();
     return true;
   }
 };
@@ -0,0 +1,82 @@
+/*
+ * InlineVector.hxx
+ *
+ * This pseudo-library provides a small vector template that stores up to N
+ * elements inline, only falling back to the heap when the size grows beyond
+ * that. This is intended for per-individual collections that are almost always
+ * small, so that adding and removing elements does not allocate. Elements must
+ * be trivially copyable (e.g., pointers) since they are moved with memcpy.
+ */
+#ifndef INLINEVECTOR_HXX
+#define INLINEVECTOR_HXX
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T, std::size_t N>
+class InlineVector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "InlineVector only supports trivially copyable types");
+
+private:
+  T inline_[N];
+  T* data_ = inline_;
+  std::size_t size_ = 0;
+  std::size_t capacity_ = N;
+
+  void grow() {
+    auto* data = new T[capacity_ * 2];
+    std::memcpy(data, data_, size_ * sizeof(T));
+    if (data_ != inline_) { delete[] data_; }
+    data_ = data;
+    capacity_ *= 2;
+  }
+
+public:
+  InlineVector() = default;
+  InlineVector(const InlineVector &) = delete;
+  InlineVector(InlineVector &&) = delete;
+  InlineVector &operator=(const InlineVector &) = delete;
+  InlineVector &operator=(InlineVector &&) = delete;
+
+  ~InlineVector() {
+    if (data_ != inline_) { delete[] data_; }
+  }
+
+  void push_back(const T &value) {
+    if (size_ == capacity_) { grow(); }
+    data_[size_++] = value;
+  }
+
+  void pop_back() { --size_; }
+
+  // Clear the elements, any heap storage is kept for reuse
+  void clear() { size_ = 0; }
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  // Return true if the elements are stored inline
+  [[nodiscard]] bool is_inline() const { return data_ == inline_; }
+
+  T &operator[](std::size_t index) { return data_[index]; }
+  const T &operator[](std::size_t index) const { return data_[index]; }
+
+  T &at(std::size_t index) {
+    if (index >= size_) {
+      throw std::out_of_range("InlineVector index out of range");
+    }
+    return data_[index];
+  }
+
+  T &back() { return data_[size_ - 1]; }
+
+  T* begin() { return data_; }
+  T* end() { return data_ + size_; }
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+};
+
+#endif
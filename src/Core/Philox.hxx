@@ -0,0 +1,179 @@
+/*
+ * Philox.hxx
+ *
+ * This pseudo-library implements the Philox4x32-10 counter-based random number
+ * generator (Salmon et al., 2011). Unlike a sequential generator the output is
+ * a pure function of a 128-bit counter and a 64-bit key, so independent
+ * streams can be created cheaply by choosing distinct keys or counters, and the
+ * values drawn from a stream do not depend upon the order in which the streams
+ * are used.
+ */
+#ifndef PHILOX_HXX
+#define PHILOX_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class Philox4x32 {
+public:
+  typedef std::array<std::uint32_t, 4> Counter;
+  typedef std::array<std::uint32_t, 2> Key;
+
+  static constexpr int ROUNDS = 10;
+
+  // Number of blocks that are generated together when filling an array
+  static constexpr int LANES = 8;
+
+private:
+  static constexpr std::uint32_t MULTIPLIER_0 = 0xD2511F53;
+  static constexpr std::uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+  static constexpr std::uint32_t WEYL_0 = 0x9E3779B9;
+  static constexpr std::uint32_t WEYL_1 = 0xBB67AE85;
+
+  static void round(Counter &counter, const Key &key) {
+    const auto product_0 =
+        static_cast<std::uint64_t>(MULTIPLIER_0) * counter[0];
+    const auto product_1 =
+        static_cast<std::uint64_t>(MULTIPLIER_1) * counter[2];
+    counter = {static_cast<std::uint32_t>(product_1 >> 32) ^ counter[1]
+                   ^ key[0],
+               static_cast<std::uint32_t>(product_1),
+               static_cast<std::uint32_t>(product_0 >> 32) ^ counter[3]
+                   ^ key[1],
+               static_cast<std::uint32_t>(product_0)};
+  }
+
+public:
+  // Return the block of four random values for the counter and key
+  static Counter generate(Counter counter, Key key) {
+    for (auto ndx = 0; ndx < ROUNDS - 1; ndx++) {
+      round(counter, key);
+      key[0] += WEYL_0;
+      key[1] += WEYL_1;
+    }
+    round(counter, key);
+    return counter;
+  }
+
+  // Generate the LANES consecutive blocks starting at the counter, block i is
+  // written to values[4i, 4i + 3]. The lanes are held as a structure of arrays
+  // so that the compiler is able to vectorize the rounds.
+  static void generate_lanes(const Counter &counter, Key key,
+                             std::uint32_t* values) {
+    std::uint32_t c0[LANES], c1[LANES], c2[LANES], c3[LANES];
+    for (std::uint32_t lane = 0; lane < LANES; lane++) {
+      c0[lane] = counter[0] + lane;
+      const std::uint32_t carry_0 = c0[lane] < lane;
+      c1[lane] = counter[1] + carry_0;
+      const std::uint32_t carry_1 = c1[lane] < carry_0;
+      c2[lane] = counter[2] + carry_1;
+      const std::uint32_t carry_2 = c2[lane] < carry_1;
+      c3[lane] = counter[3] + carry_2;
+    }
+    for (auto ndx = 0; ndx < ROUNDS; ndx++) {
+      for (auto lane = 0; lane < LANES; lane++) {
+        const auto product_0 =
+            static_cast<std::uint64_t>(MULTIPLIER_0) * c0[lane];
+        const auto product_1 =
+            static_cast<std::uint64_t>(MULTIPLIER_1) * c2[lane];
+        c0[lane] =
+            static_cast<std::uint32_t>(product_1 >> 32) ^ c1[lane] ^ key[0];
+        c1[lane] = static_cast<std::uint32_t>(product_1);
+        c2[lane] =
+            static_cast<std::uint32_t>(product_0 >> 32) ^ c3[lane] ^ key[1];
+        c3[lane] = static_cast<std::uint32_t>(product_0);
+      }
+      key[0] += WEYL_0;
+      key[1] += WEYL_1;
+    }
+    for (auto lane = 0; lane < LANES; lane++) {
+      values[4 * lane] = c0[lane];
+      values[4 * lane + 1] = c1[lane];
+      values[4 * lane + 2] = c2[lane];
+      values[4 * lane + 3] = c3[lane];
+    }
+  }
+
+  // Increment the 128-bit counter by one block
+  static void increment(Counter &counter) {
+    for (auto &word : counter) {
+      if (++word != 0) { break; }
+    }
+  }
+
+  // Advance the 128-bit counter by the number of blocks
+  static void advance(Counter &counter, std::uint32_t blocks) {
+    counter[0] += blocks;
+    if (counter[0] >= blocks) { return; }
+    for (auto ndx = 1; ndx < 4; ndx++) {
+      if (++counter[ndx] != 0) { break; }
+    }
+  }
+
+  // Sequential stream of 32-bit values for a key, starting from the counter
+  struct Stream {
+    Key key{};
+    Counter counter{};
+    Counter block{};
+    int index{4};
+
+    void reset(const Key &stream_key, const Counter &start) {
+      key = stream_key;
+      counter = start;
+      index = 4;
+    }
+
+    std::uint32_t next() {
+      if (index == 4) {
+        block = generate(counter, key);
+        increment(counter);
+        index = 0;
+      }
+      return block[index++];
+    }
+
+    // Return a random number in [0,1)
+    double uniform() { return next() * (1.0 / 4294967296.0); }
+
+    // Return a random integer in [0, bound) using Lemire's multiply and shift
+    // method, values in the biased region below the threshold are rejected so
+    // the result is uniform
+    std::uint32_t uniform_int(std::uint32_t bound) {
+      return uniform_int(bound, next());
+    }
+
+    // As above, starting from the value already drawn from the stream
+    std::uint32_t uniform_int(std::uint32_t bound, std::uint32_t value) {
+      auto product = static_cast<std::uint64_t>(value) * bound;
+      if (static_cast<std::uint32_t>(product) < bound) {
+        const std::uint32_t threshold = (0U - bound) % bound;
+        while (static_cast<std::uint32_t>(product) < threshold) {
+          product = static_cast<std::uint64_t>(next()) * bound;
+        }
+      }
+      return static_cast<std::uint32_t>(product >> 32);
+    }
+
+    // Fill the array with the next count values, this gives the same values
+    // as calling next() count times
+    void fill(std::uint32_t* values, std::size_t count) {
+      while (count > 0 && index < 4) {
+        *values++ = block[index++];
+        count--;
+      }
+      while (count >= 4 * LANES) {
+        generate_lanes(counter, key, values);
+        advance(counter, LANES);
+        values += 4 * LANES;
+        count -= 4 * LANES;
+      }
+      while (count > 0) {
+        *values++ = next();
+        count--;
+      }
+    }
+  };
+};
+
+#endif
@@ -9,50 +9,114 @@
 #include <gsl/gsl_cdf.h>
 #include <gsl/gsl_randist.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <random>
 
 #include "Helpers/NumberHelpers.hxx"
 #include "easylogging++.h"
 
-Random::Random(gsl_rng* g_rng) : seed_(0ul), G_RNG(g_rng) {}
+namespace {
+// The Philox key used by the main stream, substreams use their phase
+constexpr std::uint32_t MAIN_STREAM = 0xFFFFFFFF;
+
+// Number of raw values generated at a time by the batch sampling functions
+constexpr std::size_t BATCH_BUFFER_SIZE = 256;
+
+// Largest Poisson mean drawn by inversion in fill_poisson
+constexpr double POISSON_INVERSION_LIMIT = 10.0;
+
+// Finalizer from splitmix64, used to derive well mixed keys from the seed
+std::uint64_t mix(std::uint64_t value) {
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+Philox4x32::Key philox_key(unsigned long seed, std::uint32_t stream) {
+  const auto key = mix(seed ^ mix(stream));
+  return {static_cast<std::uint32_t>(key),
+          static_cast<std::uint32_t>(key >> 32)};
+}
+
+// Adapt a Philox4x32::Stream to the GSL generator interface so that all of the
+// GSL distributions are able to draw from it
+void philox_set(void* state, unsigned long int seed) {
+  static_cast<Philox4x32::Stream*>(state)->reset(
+      philox_key(seed, MAIN_STREAM), {0, 0, 0, 0});
+}
+
+unsigned long int philox_get(void* state) {
+  return static_cast<Philox4x32::Stream*>(state)->next();
+}
+
+double philox_get_double(void* state) {
+  return static_cast<Philox4x32::Stream*>(state)->next() / 4294967296.0;
+}
+
+const gsl_rng_type philox_type = {"philox4x32",
+                                  0xFFFFFFFFUL,
+                                  0,
+                                  sizeof(Philox4x32::Stream),
+                                  &philox_set,
+                                  &philox_get,
+                                  &philox_get_double};
+}  // namespace
+
+Random::Random(gsl_rng* g_rng) : Random(g_rng, true) {}
+
+Random::Random(gsl_rng* g_rng, bool owns_rng)
+    : seed_(0ul),
+      legacy_(false),
+      G_RNG(g_rng),
+      owns_rng_(owns_rng),
+      philox_(nullptr) {}
 
 Random::~Random() { release(); }
 
-void Random::initialize(const unsigned long &seed) {
-  const auto tt = gsl_rng_mt19937;
-  G_RNG = gsl_rng_alloc(tt);
+void Random::initialize(const unsigned long &seed, bool legacy) {
+  legacy_ = legacy;
+  G_RNG = gsl_rng_alloc(legacy_ ? gsl_rng_mt19937 : &philox_type);
+  owns_rng_ = true;
+  philox_ =
+      legacy_ ? nullptr : static_cast<Philox4x32::Stream*>(G_RNG->state);
 
   // Defer to the random device to generate a random seed
   std::random_device rd;
   seed_ = (seed == 0) ? rd() : seed;
 
-  LOG(INFO) << fmt::format("Random initializing with seed: {}", seed_);
+  LOG(INFO) << fmt::format("Random initializing with seed: {}, generator: {}",
+                           seed_, gsl_rng_name(G_RNG));
   gsl_rng_set(G_RNG, seed_);
 }
 
-void Random::release() const { gsl_rng_free(G_RNG); }
-
-int Random::random_poisson(const double &poisson_mean) {
-  return static_cast<int>(gsl_ran_poisson(G_RNG, poisson_mean));
+void Random::release() const {
+  if (owns_rng_) { gsl_rng_free(G_RNG); }
 }
 
-unsigned long Random::random_uniform(unsigned long range) {
-  return gsl_rng_uniform_int(G_RNG, range);
+RandomStream Random::substream(RandomPhase phase, std::uint64_t id,
+                               std::uint32_t day) const {
+  return RandomStream(seed_, phase, id, day);
 }
 
-// return an integer in  [from, to) , not include to
-unsigned long Random::random_uniform_int(const unsigned long &from,
-                                         const unsigned long &to) {
-  return from + gsl_rng_uniform_int(G_RNG, to - from);
-}
+RandomStream::RandomStream(unsigned long seed, RandomPhase phase,
+                           std::uint64_t id, std::uint32_t day)
+    : Random(&rng_, false), rng_{&philox_type, &state_} {
+  set_seed(seed);
 
-double Random::random_uniform_double(const double &from, const double &to) {
-  //    return from + gsl_rng_uniform_pos(G_RNG)*(to-from);
-  return gsl_ran_flat(G_RNG, from, to);
+  // The low word of the counter is left for the blocks drawn from the stream,
+  // which allows for 2^34 values before running into the next day
+  state_.reset(philox_key(seed, static_cast<std::uint32_t>(phase)),
+               {0, day, static_cast<std::uint32_t>(id),
+                static_cast<std::uint32_t>(id >> 32)});
+  philox_ = &state_;
 }
 
-double Random::random_uniform() { return gsl_rng_uniform(G_RNG); }
+int Random::random_poisson(const double &poisson_mean) {
+  return static_cast<int>(gsl_ran_poisson(G_RNG, poisson_mean));
+}
 
 double Random::random_normal(const double &mean, const double &sd) {
   return mean + gsl_ran_gaussian(G_RNG, sd);
@@ -110,12 +174,8 @@ double Random::cdf_gamma_distribution_inverse(const double &p,
   return gsl_cdf_gamma_Pinv(p, alpha, beta);
 }
 
-double Random::random_flat(const double &from, const double &to) {
-  return gsl_ran_flat(G_RNG, from, to);
-}
-
 void Random::random_multinomial(const std::size_t &K, const unsigned &N,
-                                double p[], unsigned n[]) {
+                                const double p[], unsigned n[]) {
   gsl_ran_multinomial(G_RNG, K, N, p, n);
 }
 
@@ -132,7 +192,102 @@ int Random::random_binomial(const double &p, const unsigned int &n) {
   return static_cast<int>(gsl_ran_binomial(G_RNG, p, n));
 }
 
+unsigned int Random::random_geometric(const double &p) {
+  if (p >= 1.0) return 1;
+
+  // Inverse transform, this is the same as gsl_ran_geometric but guards against
+  // overflowing the return value when the probability is very small
+  const auto trials =
+      std::ceil(std::log(gsl_rng_uniform_pos(G_RNG)) / std::log1p(-p));
+  if (trials >= std::numeric_limits<unsigned int>::max()) {
+    return std::numeric_limits<unsigned int>::max();
+  }
+  return trials < 1.0 ? 1 : static_cast<unsigned int>(trials);
+}
+
 void Random::shuffle(void* base, const std::size_t &n,
                      const std::size_t &size) const {
   gsl_ran_shuffle(G_RNG, base, n, size);
 }
+
+void Random::fill_uniform(double* values, std::size_t count) {
+  if (philox_ == nullptr) {
+    for (std::size_t ndx = 0; ndx < count; ndx++) {
+      values[ndx] = gsl_rng_uniform(G_RNG);
+    }
+    return;
+  }
+
+  std::uint32_t buffer[BATCH_BUFFER_SIZE];
+  while (count > 0) {
+    const auto size = std::min<std::size_t>(count, BATCH_BUFFER_SIZE);
+    philox_->fill(buffer, size);
+    for (std::size_t ndx = 0; ndx < size; ndx++) {
+      values[ndx] = buffer[ndx] / 4294967296.0;
+    }
+    values += size;
+    count -= size;
+  }
+}
+
+void Random::fill_uniform_int(unsigned long range, unsigned long* values,
+                              std::size_t count) {
+  if (philox_ == nullptr || range > 0xFFFFFFFFUL) {
+    for (std::size_t ndx = 0; ndx < count; ndx++) {
+      values[ndx] = gsl_rng_uniform_int(G_RNG, range);
+    }
+    return;
+  }
+
+  const auto bound = static_cast<std::uint32_t>(range);
+  std::uint32_t buffer[BATCH_BUFFER_SIZE];
+  while (count > 0) {
+    const auto size = std::min<std::size_t>(count, BATCH_BUFFER_SIZE);
+    philox_->fill(buffer, size);
+    for (std::size_t ndx = 0; ndx < size; ndx++) {
+      values[ndx] = philox_->uniform_int(bound, buffer[ndx]);
+    }
+    values += size;
+    count -= size;
+  }
+}
+
+void Random::fill_poisson(const double* means, int* values,
+                          std::size_t count) {
+  if (philox_ == nullptr) {
+    for (std::size_t ndx = 0; ndx < count; ndx++) {
+      values[ndx] = static_cast<int>(gsl_ran_poisson(G_RNG, means[ndx]));
+    }
+    return;
+  }
+
+  // Small means are drawn by inversion, one uniform from the block for each
+  // value, larger means fall back to the GSL sampler
+  std::uint32_t buffer[BATCH_BUFFER_SIZE];
+  while (count > 0) {
+    const auto size = std::min<std::size_t>(count, BATCH_BUFFER_SIZE);
+    philox_->fill(buffer, size);
+    for (std::size_t ndx = 0; ndx < size; ndx++) {
+      const auto mean = means[ndx];
+      if (mean >= POISSON_INVERSION_LIMIT) {
+        values[ndx] = static_cast<int>(gsl_ran_poisson(G_RNG, mean));
+        continue;
+      }
+      const auto uniform = buffer[ndx] / 4294967296.0;
+      auto probability = std::exp(-mean);
+      auto cdf = probability;
+      auto value = 0;
+      while (uniform >= cdf) {
+        value++;
+        probability *= mean / value;
+        // Stop once the tail no longer changes the sum
+        if (value > mean && probability < 1e-15) { break; }
+        cdf += probability;
+      }
+      values[ndx] = value;
+    }
+    means += size;
+    values += size;
+    count -= size;
+  }
+}
@@ -11,74 +11,183 @@
 #include <gsl/gsl_rng.h>
 
 #include <cstddef>
+#include <cstdint>
 
+#include "Philox.hxx"
 #include "PropertyMacro.h"
 
+// The methods of Random are only virtual when ENABLE_RANDOM_MOCKING is defined
+// so that they may be mocked in tests. Otherwise, the calls are bound
+// statically and the methods defined in this header are able to be inlined
+// into the hot loops of the simulation.
+#ifdef ENABLE_RANDOM_MOCKING
+#define RANDOM_VIRTUAL virtual
+#else
+#define RANDOM_VIRTUAL
+#endif
+
 class Model;
+class RandomStream;
+
+// The phases of the simulation that may draw from keyed substreams, the phase
+// is part of the key so that the substreams for each phase are independent
+enum class RandomPhase : std::uint32_t {
+  GENERAL,
+  INFECTION,
+  CIRCULATION,
+  DEATH,
+  BIRTH,
+  REPORTING
+};
 
 class Random {
   DELETE_COPY_AND_MOVE(Random)
 
   VIRTUAL_PROPERTY(unsigned long, seed)
 
+  // True if the legacy Mersenne Twister (gsl_rng_mt19937) stream is used,
+  // otherwise the main stream is a Philox4x32 counter-based stream
+  PROPERTY(bool, legacy)
+
 private:
   gsl_rng* G_RNG;
 
+  // True if G_RNG was allocated by, and must be freed by, this object
+  bool owns_rng_;
+
+protected:
+  // The Philox stream that G_RNG draws from, or nullptr if the legacy generator
+  // is in use
+  Philox4x32::Stream* philox_;
+
+  Random(gsl_rng* g_rng, bool owns_rng);
+
 public:
   explicit Random(gsl_rng* g_rng = nullptr);
 
   virtual ~Random();
 
-  void initialize(const unsigned long &seed = 0);
+  void initialize(const unsigned long &seed = 0, bool legacy = false);
 
   void release() const;
 
-  virtual int random_poisson(const double &poisson_mean);
-
-  virtual unsigned long random_uniform(unsigned long range);
-
-  virtual unsigned long random_uniform_int(const unsigned long &from,
-                                           const unsigned long &to);
-
-  virtual double random_uniform_double(const double &from, const double &to);
+  // Return a substream keyed by the phase, an identifier (ex., the location or
+  // person id), and the day. The values drawn from a substream only depend
+  // upon the seed and the key; so parallel code that draws from the substream
+  // for each unit of work gives the same results regardless of the number of
+  // threads or the order the work is scheduled. Substreams are always counter
+  // based, even when the legacy main stream is in use.
+  [[nodiscard]] RandomStream substream(RandomPhase phase, std::uint64_t id,
+                                       std::uint32_t day) const;
+
+  RANDOM_VIRTUAL int random_poisson(const double &poisson_mean);
+
+  // Return a random integer in [0, range)
+  RANDOM_VIRTUAL unsigned long random_uniform(unsigned long range) {
+    if (philox_ != nullptr && range <= 0xFFFFFFFFUL) {
+      return philox_->uniform_int(static_cast<std::uint32_t>(range));
+    }
+    return gsl_rng_uniform_int(G_RNG, range);
+  }
+
+  // return an integer in  [from, to) , not include to
+  RANDOM_VIRTUAL unsigned long random_uniform_int(const unsigned long &from,
+                                                  const unsigned long &to) {
+    return from + random_uniform(to - from);
+  }
+
+  RANDOM_VIRTUAL double random_uniform_double(const double &from,
+                                              const double &to) {
+    return random_flat(from, to);
+  }
 
   /*
    * This function will return a random number in [0,1)
    */
-  virtual double random_uniform();
+  RANDOM_VIRTUAL double random_uniform() {
+    return (philox_ != nullptr) ? philox_->uniform() : gsl_rng_uniform(G_RNG);
+  }
 
-  virtual double random_normal(const double &mean, const double &sd);
+  RANDOM_VIRTUAL double random_normal(const double &mean, const double &sd);
 
-  virtual double random_normal_truncated(const double &mean, const double &sd);
+  RANDOM_VIRTUAL double random_normal_truncated(const double &mean,
+                                                const double &sd);
 
-  virtual int random_normal(const int &mean, const int &sd);
+  RANDOM_VIRTUAL int random_normal(const int &mean, const int &sd);
 
-  virtual int random_normal_truncated(const int &mean, const int &sd);
+  RANDOM_VIRTUAL int random_normal_truncated(const int &mean, const int &sd);
 
-  virtual double random_beta(const double &alpha, const double &beta);
+  RANDOM_VIRTUAL double random_beta(const double &alpha, const double &beta);
 
-  virtual double random_gamma(const double &shape, const double &scale);
+  RANDOM_VIRTUAL double random_gamma(const double &shape,
+                                     const double &scale);
 
-  virtual double cdf_gamma_distribution(const double &x, const double &alpha,
-                                        const double &beta);
+  RANDOM_VIRTUAL double cdf_gamma_distribution(const double &x,
+                                               const double &alpha,
+                                               const double &beta);
 
-  virtual double cdf_gamma_distribution_inverse(const double &p,
-                                                const double &alpha,
-                                                const double &beta);
+  RANDOM_VIRTUAL double cdf_gamma_distribution_inverse(const double &p,
+                                                       const double &alpha,
+                                                       const double &beta);
 
-  virtual double random_flat(const double &from, const double &to);
+  // Return a random number in [from, to), this is the same calculation as
+  // gsl_ran_flat
+  RANDOM_VIRTUAL double random_flat(const double &from, const double &to) {
+    const auto u = random_uniform();
+    return from * (1 - u) + to * u;
+  }
 
-  virtual void random_multinomial(const std::size_t &K, const unsigned &N,
-                                  double p[], unsigned n[]);
+  RANDOM_VIRTUAL void random_multinomial(const std::size_t &K,
+                                         const unsigned &N,
+                                         const double p[], unsigned n[]);
 
-  virtual void random_shuffle(void* base, std::size_t base_length,
-                              std::size_t size_of_type);
+  RANDOM_VIRTUAL void random_shuffle(void* base, std::size_t base_length,
+                                     std::size_t size_of_type);
 
-  virtual double cdf_standard_normal_distribution(const double &p);
+  RANDOM_VIRTUAL double cdf_standard_normal_distribution(const double &p);
 
-  virtual int random_binomial(const double &p, const unsigned int &n);
+  RANDOM_VIRTUAL int random_binomial(const double &p, const unsigned int &n);
+
+  /*
+   * Return the number of Bernoulli trials with probability p up to and
+   * including the first success, i.e., a value in [1, UINT_MAX]
+   */
+  RANDOM_VIRTUAL unsigned int random_geometric(const double &p);
 
   void shuffle(void* base, const std::size_t &n, const std::size_t &size) const;
+
+  // Batch sampling, each of these fill the array with count values. When the
+  // counter-based generator is in use the values are generated directly from
+  // blocks of Philox output instead of one call at a time, so callers that need
+  // many values should prefer these.
+
+  // Fill the values with random numbers in [0,1)
+  RANDOM_VIRTUAL void fill_uniform(double* values, std::size_t count);
+
+  // Fill the values with random integers in [0, range)
+  RANDOM_VIRTUAL void fill_uniform_int(unsigned long range,
+                                       unsigned long* values,
+                                       std::size_t count);
+
+  // Fill the values with Poisson draws, one for each of the means
+  RANDOM_VIRTUAL void fill_poisson(const double* means, int* values,
+                                   std::size_t count);
+};
+
+// A lightweight keyed substream, see Random::substream. The generator state is
+// held inline so creating a substream does not allocate.
+class RandomStream final : public Random {
+  DELETE_COPY_AND_MOVE(RandomStream)
+
+private:
+  Philox4x32::Stream state_;
+  gsl_rng rng_;
+
+public:
+  RandomStream(unsigned long seed, RandomPhase phase, std::uint64_t id,
+               std::uint32_t day);
+
+  ~RandomStream() override = default;
 };
 
 #endif /* RANDOM_H */
@@ -0,0 +1,54 @@
+/*
+ * RelativeInfectivity.hxx
+ *
+ * Defines the relative infectivity of a host to mosquitoes as a function of the
+ * log10 parasite density, Phi(log10_density * sigma + ro_star)^2 + 0.01, which
+ * is precomputed as an interpolation table once the configuration is loaded.
+ */
+#ifndef RELATIVEINFECTIVITY_HXX
+#define RELATIVEINFECTIVITY_HXX
+
+#include <cmath>
+#include <ostream>
+
+#include "Helpers/LookupTables.hxx"
+
+struct RelativeInfectivity {
+  // Range of the standard normal deviate covered by the infectivity curve, the
+  // squared CDF is constant to double precision outside of it
+  static constexpr double CURVE_LIMIT = 8.5;
+  static constexpr int CURVE_INTERVALS = 4096;
+
+  double sigma;
+  double ro_star;
+
+  // Precomputed infectivity, Phi(log10_density * sigma + ro_star)^2 + 0.01,
+  // over the log10 parasite density
+  InterpolationTable curve;
+
+  // Build the infectivity curve, this must be called once sigma and ro_star
+  // have been set
+  void build_curve() {
+    const auto s = sigma;
+    const auto r = ro_star;
+    curve = InterpolationTable(
+        (-CURVE_LIMIT - r) / s, (CURVE_LIMIT - r) / s, CURVE_INTERVALS,
+        [s, r, root2 = std::sqrt(2.0)](double log10_density) {
+          const auto p = 0.5 * std::erfc(-(log10_density * s + r) / root2);
+          return p * p + 0.01;
+        });
+  }
+
+  // Return the relative infectivity for the log10 parasite density
+  [[nodiscard]] double operator()(double log10_density) const {
+    return curve(log10_density);
+  }
+
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const RelativeInfectivity &e) {
+    os << "[" << e.sigma << "," << e.ro_star << "]";
+    return os;
+  }
+};
+
+#endif
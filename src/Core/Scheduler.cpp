@@ -5,6 +5,7 @@
  */
 #include "Scheduler.h"
 
+#include <algorithm>
 #include <iomanip>
 
 #include "Core/Config/Config.h"
@@ -13,6 +14,7 @@
 #include "Helpers/ObjectHelpers.h"
 #include "Helpers/TimeHelpers.h"
 #include "Model.h"
+#include "Population/Population.h"
 #include "easylogging++.h"
 
 using namespace date;
@@ -22,7 +24,8 @@ Scheduler::Scheduler(Model* model)
       total_available_time_(-1),
       model_(model),
       is_force_stop_(false),
-      days_between_notifications_(0) {}
+      days_between_notifications_(0),
+      resume_time_(-1) {}
 
 Scheduler::~Scheduler() { clear_all_events(); }
 
@@ -129,6 +132,7 @@ void Scheduler::run() {
     execute_events_list(individual_events_list_[current_time_]);
 
     end_time_step();
+    update_fast_forward();
 
     calendar_date += days{1};
   }
@@ -142,6 +146,38 @@ void Scheduler::begin_time_step() const {
 
 void Scheduler::end_time_step() const { model_->daily_update(current_time_); }
 
+int Scheduler::next_introduction_time() const {
+  const auto last = std::min(Model::CONFIG->total_time() + 1,
+                             static_cast<int>(population_events_list_.size()));
+  for (auto time = current_time_ + 1; time < last; time++) {
+    for (auto* event : population_events_list_[time]) {
+      if (event->executable && event->introduces_parasites()) { return time; }
+    }
+  }
+  return last;
+}
+
+void Scheduler::update_fast_forward() {
+  if (!Model::CONFIG->fast_forward_without_parasites()) { return; }
+
+  // Resume as soon as there may be transmission
+  if (!model_->population()->is_free_of_parasites()) {
+    LOG_IF(fast_forward(), INFO)
+        << "Day: " << current_time_ << " - Parasites present, resuming";
+    resume_time_ = -1;
+    return;
+  }
+  if (resume_time_ > current_time_ + 1) { return; }
+
+  // Either the population just became free of parasites, or the expected
+  // introduction did not take place, so find the next one
+  resume_time_ = next_introduction_time();
+  LOG_IF(resume_time_ > current_time_ + 1, INFO)
+      << "Day: " << current_time_
+      << " - No parasites present, deferring updates until day "
+      << resume_time_;
+}
+
 bool Scheduler::can_stop() const {
   return current_time_ > Model::CONFIG->total_time() || is_force_stop_;
 }
@@ -29,6 +29,10 @@ class Scheduler {
   // Number of days to wait between updating the user
   PROPERTY(int, days_between_notifications)
 
+  // Day that parasites may next be introduced while the population is free of
+  // parasites, or -1 when the full model is running
+  READ_ONLY_PROPERTY(int, resume_time)
+
 private:
   // Padding interval to use on the end of the total simulation time
   const int SCHEDULE_PADDING = 365 * 2;
@@ -44,6 +48,14 @@ private:
   [[nodiscard]] bool is_today_first_day_of_month() const;
   [[nodiscard]] bool is_today_first_day_of_year() const;
 
+  // Return the first day after today with a population event that may
+  // introduce parasites, or the last day of the simulation
+  [[nodiscard]] int next_introduction_time() const;
+
+  // Check the population at the end of the day and start or stop deferring
+  // the updates of the individuals
+  void update_fast_forward();
+
 public:
   date::sys_days calendar_date;
 
@@ -76,6 +88,12 @@ public:
 
   // Return the current day in the year based upon the current scheduler day
   [[nodiscard]] int current_day_in_year() const;
+
+  // Return true if the population is free of parasites and none will be
+  // introduced before the resume time, so only the demography is updated
+  [[nodiscard]] bool fast_forward() const {
+    return resume_time_ > current_time_;
+  }
 };
 
 #endif
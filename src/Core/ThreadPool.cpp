@@ -0,0 +1,92 @@
+/*
+ * ThreadPool.cpp
+ *
+ * Implement the ThreadPool class.
+ */
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threads) {
+  for (auto ndx = 1; ndx < threads; ndx++) {
+    workers_.emplace_back(&ThreadPool::worker_loop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  start_.notify_all();
+  for (auto &worker : workers_) { worker.join(); }
+}
+
+void ThreadPool::worker_loop() {
+  std::size_t generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    start_.wait(lock,
+                [&] { return stopping_ || generation_ != generation; });
+    if (stopping_) { return; }
+    generation = generation_;
+    run_chunks(lock);
+  }
+}
+
+void ThreadPool::run_chunks(std::unique_lock<std::mutex> &lock) {
+  while (next_chunk_ < chunks_) {
+    const auto chunk = next_chunk_++;
+    const auto* work = work_;
+    const auto begin = chunk * grain_;
+    const auto end = std::min(begin + grain_, count_);
+
+    lock.unlock();
+    try {
+      (*work)(chunk, begin, end);
+    } catch (...) {
+      lock.lock();
+      if (!error_) { error_ = std::current_exception(); }
+      lock.unlock();
+    }
+    lock.lock();
+
+    if (++completed_ == chunks_) { finished_.notify_all(); }
+  }
+}
+
+void ThreadPool::parallel_for(std::size_t count, std::size_t grain,
+                              const Work &work) {
+  if (count == 0) { return; }
+  grain = std::max<std::size_t>(grain, 1);
+
+  // Nothing to share, so run the work on the calling thread
+  if (workers_.empty() || count <= grain) {
+    for (std::size_t chunk = 0; chunk < chunk_count(count, grain); chunk++) {
+      work(chunk, chunk * grain, std::min((chunk + 1) * grain, count));
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_ = &work;
+  count_ = count;
+  grain_ = grain;
+  next_chunk_ = 0;
+  chunks_ = chunk_count(count, grain);
+  completed_ = 0;
+  error_ = nullptr;
+  generation_++;
+  start_.notify_all();
+
+  // Do work on this thread as well, then wait for the workers to finish
+  run_chunks(lock);
+  finished_.wait(lock, [&] { return completed_ == chunks_; });
+  work_ = nullptr;
+
+  if (error_) {
+    auto error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
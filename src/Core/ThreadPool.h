@@ -0,0 +1,76 @@
+/*
+ * ThreadPool.h
+ *
+ * Define a fixed pool of worker threads that is owned by the model and used to
+ * run the independent parts of a time step in parallel. Work is divided into
+ * chunks of a fixed grain size, so the chunks (and any results that are merged
+ * per chunk) are the same regardless of the number of threads.
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Core/PropertyMacro.h"
+
+class ThreadPool {
+  DELETE_COPY_AND_MOVE(ThreadPool)
+
+public:
+  // Work for a chunk, called with the chunk index and the range [begin, end)
+  typedef std::function<void(std::size_t, std::size_t, std::size_t)> Work;
+
+private:
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable finished_;
+
+  // State of the current parallel_for, guarded by the mutex
+  const Work* work_{nullptr};
+  std::size_t count_{0};
+  std::size_t grain_{0};
+  std::size_t next_chunk_{0};
+  std::size_t chunks_{0};
+  std::size_t completed_{0};
+  std::size_t generation_{0};
+  std::exception_ptr error_;
+  bool stopping_{false};
+
+  void worker_loop();
+
+  // Run chunks of the current work until there are none left
+  void run_chunks(std::unique_lock<std::mutex> &lock);
+
+public:
+  // Create the pool, the calling thread also does work so threads - 1 workers
+  // are started
+  explicit ThreadPool(int threads = 1);
+
+  ~ThreadPool();
+
+  // Return the number of threads that do work, including the caller
+  [[nodiscard]] int threads() const {
+    return static_cast<int>(workers_.size()) + 1;
+  }
+
+  // Return the number of chunks that count items are divided into
+  [[nodiscard]] static std::size_t chunk_count(std::size_t count,
+                                               std::size_t grain) {
+    return (count + grain - 1) / grain;
+  }
+
+  // Run the work for each chunk of grain items in [0, count) and wait for all
+  // of the chunks to complete. The first exception thrown by the work is
+  // rethrown once all of the chunks are done.
+  void parallel_for(std::size_t count, std::size_t grain, const Work &work);
+};
+
+#endif
@@ -14,6 +14,8 @@
 #include <string>
 #include <vector>
 
+#include "Helpers/LookupTables.hxx"
+
 class Person;
 
 class PersonIndex;
@@ -22,8 +24,6 @@ class Event;
 
 class Reporter;
 
-class Drug;
-
 class IStrategy;
 
 class Therapy;
@@ -63,8 +63,6 @@ using ReporterPtrVector = std::vector<Reporter*>;
 
 using PersonIndexPtrList = std::list<PersonIndex*>;
 
-using DrugPtrMap = std::map<int, Drug*>;
-
 using TherapyPtrVector = std::vector<Therapy*>;
 using StrategyPtrVector = std::vector<IStrategy*>;
 
@@ -97,6 +95,14 @@ struct ImmuneSystemInformation {
 
   // Parameter kappa in supplement of 2015 LGH paper
   double factor_effect_age_mature_immunity{-1};
+
+  // Precomputed exp(-rate * duration) terms for the acquisition of immunity by
+  // age and for the decay of immunity
+  std::vector<ExponentialDecayTable> acquire_by_age;
+  ExponentialDecayTable decay;
+
+  // Precomputed probability of progressing to clinical by immune level
+  InterpolationTable clinical_progression;
 };
 
 struct ParasiteDensityLevel {
@@ -185,17 +191,6 @@ struct InitialParasiteInfo {
       : location(loc), parasite_type_id(p_type), prevalence(pre){};
 };
 
-struct RelativeInfectivity {
-  double sigma;
-  double ro_star;
-
-  friend std::ostream &operator<<(std::ostream &os,
-                                  const RelativeInfectivity &e) {
-    os << "[" << e.sigma << "," << e.ro_star << "]";
-    return os;
-  }
-};
-
 struct Allele {
   int value;  // we can do char later or map from char to int
   std::string name;
@@ -76,6 +76,8 @@ int main(int argc, char** argv) {
   if (as_ec50 != -1) {
     p_model->CONFIG->EC50_power_n_table()[0][0] =
         pow(as_ec50, p_model->CONFIG->drug_db()->at(0)->n());
+    p_model->CONFIG->drug_db()->at(0)->build_killing_rate_tables(
+        p_model->CONFIG->EC50_power_n_table());
   }
 
   // initialEC50Table
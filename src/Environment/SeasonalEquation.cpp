@@ -4,6 +4,8 @@
  * Implement the equation based seasonal model.
  */
 #include <cmath>
+#include <map>
+#include <tuple>
 
 #include "Constants.h"
 #include "Core/Config/Config.h"
@@ -23,6 +25,7 @@ SeasonalEquation* SeasonalEquation::build(const YAML::Node &node,
   // Before doing anything, check to see if there is a raster
   if (settings["raster"] && settings["raster"].as<bool>()) {
     value->set_from_raster(settings);
+    value->prepare_tables();
     return value;
   }
 
@@ -54,25 +57,54 @@ SeasonalEquation* SeasonalEquation::build(const YAML::Node &node,
         settings["a"].size() < config->number_of_locations() ? 0 : i;
     value->set_seasonal_period(settings, input_loc);
   }
+  value->prepare_tables();
   return value;
 }
 
 double SeasonalEquation::get_seasonal_factor(const date::sys_days &today,
                                              const int &location) {
-  // Note what day of the year it is
+  // Note what day of the year it is, one-indexed
   int day = TimeHelpers::day_of_year(today);
+  return tables[table_index[location]][day - 1];
+}
+
+void SeasonalEquation::get_seasonal_factors(const date::sys_days &today,
+                                            DoubleVector &factors) {
+  int day = TimeHelpers::day_of_year(today);
+  for (std::size_t loc = 0; loc < factors.size(); loc++) {
+    factors[loc] = tables[table_index[loc]][day - 1];
+  }
+}
 
-  // Seasonal factor is determined by the algorithm:
-  //
-  // multiplier = base + (a * sin⁺(b * pi * (t - phi) / 365))
-  auto multiplier = A[location]
-                    * sin(B[location] * M_PI * (day - phi[location])
-                          / Constants::DAYS_IN_YEAR());
-  multiplier = (multiplier < 0) ? 0 : multiplier;
-  multiplier += base[location];
-
-  // Return the multiplier
-  return multiplier;
+// Tabulate the seasonal factor for each day of the year, locations sharing
+// the same parameters share the same table.
+void SeasonalEquation::prepare_tables() {
+  std::map<std::tuple<double, double, double, double>, int> lookup;
+  tables.clear();
+  table_index.resize(base.size());
+  for (std::size_t loc = 0; loc < base.size(); loc++) {
+    auto key = std::make_tuple(base[loc], A[loc], B[loc], phi[loc]);
+    auto found = lookup.find(key);
+    if (found != lookup.end()) {
+      table_index[loc] = found->second;
+      continue;
+    }
+
+    // Seasonal factor is determined by the algorithm:
+    //
+    // multiplier = base + (a * sin⁺(b * pi * (t - phi) / 365))
+    DoubleVector table(366);
+    for (int day = 1; day <= 366; day++) {
+      auto multiplier = A[loc]
+                        * sin(B[loc] * M_PI * (day - phi[loc])
+                              / Constants::DAYS_IN_YEAR());
+      multiplier = (multiplier < 0) ? 0 : multiplier;
+      table[day - 1] = multiplier + base[loc];
+    }
+    table_index[loc] = static_cast<int>(tables.size());
+    lookup[key] = table_index[loc];
+    tables.push_back(std::move(table));
+  }
 }
 
 // Set the values based upon the contents of a raster file.
@@ -140,4 +172,5 @@ void SeasonalEquation::update_seasonality(int from, int to) {
       phi[ndx] = reference_phi[to];
     }
   }
+  prepare_tables();
 }
@@ -25,6 +25,15 @@ public:
                                      const int &location) {
     throw std::runtime_error("Runtime call to virtual function");
   }
+
+  // Set the seasonal factor of each location for the given day, the size of
+  // the factors determines the number of locations.
+  virtual void get_seasonal_factors(const date::sys_days &today,
+                                    DoubleVector &factors) {
+    for (std::size_t loc = 0; loc < factors.size(); loc++) {
+      factors[loc] = get_seasonal_factor(today, static_cast<int>(loc));
+    }
+  }
 };
 
 class SeasonalDisabled : public ISeasonalInfo {
@@ -33,6 +42,11 @@ public:
                              const int &location) override {
     return 1.0;
   }
+
+  void get_seasonal_factors(const date::sys_days &today,
+                            DoubleVector &factors) override {
+    std::fill(factors.begin(), factors.end(), 1.0);
+  }
 };
 
 class SeasonalEquation : public ISeasonalInfo {
@@ -50,6 +64,12 @@ private:
   DoubleVector reference_B;
   DoubleVector reference_phi;
 
+  // The factor for each day of the year is tabulated for each distinct set of
+  // parameters (i.e., ecozone), along with the table used by each location
+  std::vector<DoubleVector> tables;
+  IntVector table_index;
+
+  void prepare_tables();
   void set_from_raster(const YAML::Node &node);
   void set_seasonal_period(const YAML::Node &node, unsigned long index);
 
@@ -57,6 +77,8 @@ public:
   static SeasonalEquation* build(const YAML::Node &node, Config* config);
   double get_seasonal_factor(const date::sys_days &today,
                              const int &location) override;
+  void get_seasonal_factors(const date::sys_days &today,
+                            DoubleVector &factors) override;
   void update_seasonality(int from, int to);
 };
 
@@ -71,6 +93,12 @@ public:
   static SeasonalRainfall* build(const YAML::Node &node);
   double get_seasonal_factor(const date::sys_days &today,
                              const int &location) override;
+
+  // The adjustment is the same for all locations
+  void get_seasonal_factors(const date::sys_days &today,
+                            DoubleVector &factors) override {
+    std::fill(factors.begin(), factors.end(), get_seasonal_factor(today, 0));
+  }
 };
 
 class SeasonalInfoFactory {
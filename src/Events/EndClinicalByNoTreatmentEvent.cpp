@@ -19,7 +19,7 @@
 OBJECTPOOL_IMPL(EndClinicalByNoTreatmentEvent)
 
 EndClinicalByNoTreatmentEvent::EndClinicalByNoTreatmentEvent()
-    : clinical_caused_parasite_(nullptr) {}
+    : clinical_caused_parasite_(nullptr), clinical_caused_parasite_uid_(0) {}
 
 EndClinicalByNoTreatmentEvent::~EndClinicalByNoTreatmentEvent() = default;
 
@@ -30,6 +30,7 @@ void EndClinicalByNoTreatmentEvent::schedule_event(
     auto* e = new EndClinicalByNoTreatmentEvent();
     e->dispatcher = p;
     e->set_clinical_caused_parasite(clinical_caused_parasite);
+    e->set_clinical_caused_parasite_uid(clinical_caused_parasite->get_uid());
     e->time = time;
 
     p->add(e);
@@ -49,12 +50,13 @@ void EndClinicalByNoTreatmentEvent::execute() {
     person->immune_system()->set_increase(true);
     person->set_host_state(Person::ASYMPTOMATIC);
     if (person->all_clonal_parasite_populations()->contain(
-            clinical_caused_parasite_)) {
+            clinical_caused_parasite_, clinical_caused_parasite_uid_)) {
       clinical_caused_parasite_->set_last_update_log10_parasite_density(
           Model::CONFIG->parasite_density_level()
               .log_parasite_density_asymptomatic);
 
-      person->determine_relapse_or_not(clinical_caused_parasite_);
+      person->determine_relapse_or_not(clinical_caused_parasite_,
+                                       clinical_caused_parasite_uid_);
     }
     //        std::cout <<
     //        clinical_caused_parasite_->last_update_log10_parasite_density()<<
@@ -18,7 +18,7 @@
 OBJECTPOOL_IMPL(EndClinicalDueToDrugResistanceEvent)
 
 EndClinicalDueToDrugResistanceEvent::EndClinicalDueToDrugResistanceEvent()
-    : clinical_caused_parasite_(nullptr) {}
+    : clinical_caused_parasite_(nullptr), clinical_caused_parasite_uid_(0) {}
 
 EndClinicalDueToDrugResistanceEvent::~EndClinicalDueToDrugResistanceEvent() =
     default;
@@ -30,6 +30,7 @@ void EndClinicalDueToDrugResistanceEvent::schedule_event(
     auto* e = new EndClinicalDueToDrugResistanceEvent();
     e->dispatcher = p;
     e->set_clinical_caused_parasite(clinical_caused_parasite);
+    e->set_clinical_caused_parasite_uid(clinical_caused_parasite->get_uid());
     e->time = time;
 
     p->add(e);
@@ -48,12 +49,13 @@ void EndClinicalDueToDrugResistanceEvent::execute() {
     person->set_host_state(Person::ASYMPTOMATIC);
 
     if (person->all_clonal_parasite_populations()->contain(
-            clinical_caused_parasite_)) {
+            clinical_caused_parasite_, clinical_caused_parasite_uid_)) {
       clinical_caused_parasite_->set_last_update_log10_parasite_density(
           Model::CONFIG->parasite_density_level()
               .log_parasite_density_asymptomatic);
 
-      person->determine_relapse_or_not(clinical_caused_parasite_);
+      person->determine_relapse_or_not(clinical_caused_parasite_,
+                                       clinical_caused_parasite_uid_);
     }
 
     //        person->determine_relapse_or_not(clinical_caused_parasite_);
@@ -68,7 +70,7 @@ void EndClinicalDueToDrugResistanceEvent::execute() {
     //            std::endl; assert(false);
     //        }
     //        clinical_caused_parasite_->set_last_update_log10_parasite_density(Model::CONFIG->parasite_density_level().log_parasite_density_asymptomatic);
-    //        clinical_caused_parasite_->set_update_function(Model::MODEL->immunity_clearance_update_function());
+    //        clinical_caused_parasite_->set_update_function(ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
     //        //        std::cout << "hello" << std::endl;
   }
 }
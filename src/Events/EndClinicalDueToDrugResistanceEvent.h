@@ -11,6 +11,7 @@
 #include "Core/ObjectPool.h"
 #include "Core/PropertyMacro.h"
 #include "Event.h"
+#include "Helpers/UniqueId.hxx"
 
 class ClonalParasitePopulation;
 
@@ -24,6 +25,7 @@ class EndClinicalDueToDrugResistanceEvent : public Event {
   OBJECTPOOL(EndClinicalDueToDrugResistanceEvent)
 
   POINTER_PROPERTY(ClonalParasitePopulation, clinical_caused_parasite)
+  PROPERTY_REF(ul_uid, clinical_caused_parasite_uid)
 
 public:
   EndClinicalDueToDrugResistanceEvent();
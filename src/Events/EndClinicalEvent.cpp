@@ -15,7 +15,8 @@
 
 OBJECTPOOL_IMPL(EndClinicalEvent)
 
-EndClinicalEvent::EndClinicalEvent() : clinical_caused_parasite_(nullptr) {}
+EndClinicalEvent::EndClinicalEvent()
+    : clinical_caused_parasite_(nullptr), clinical_caused_parasite_uid_(0) {}
 
 EndClinicalEvent::~EndClinicalEvent() = default;
 
@@ -26,6 +27,7 @@ void EndClinicalEvent::schedule_event(
     auto* e = new EndClinicalEvent();
     e->dispatcher = p;
     e->set_clinical_caused_parasite(clinical_caused_parasite);
+    e->set_clinical_caused_parasite_uid(clinical_caused_parasite->get_uid());
     e->time = time;
 
     p->add(e);
@@ -44,6 +46,7 @@ void EndClinicalEvent::execute() {
     person->immune_system()->set_increase(true);
     person->set_host_state(Person::ASYMPTOMATIC);
 
-    person->determine_relapse_or_not(clinical_caused_parasite_);
+    person->determine_relapse_or_not(clinical_caused_parasite_,
+                                     clinical_caused_parasite_uid_);
   }
 }
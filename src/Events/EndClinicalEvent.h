@@ -11,6 +11,7 @@
 #include "Core/ObjectPool.h"
 #include "Core/PropertyMacro.h"
 #include "Event.h"
+#include "Helpers/UniqueId.hxx"
 
 class ClonalParasitePopulation;
 
@@ -23,6 +24,7 @@ class EndClinicalEvent : public Event {
   OBJECTPOOL(EndClinicalEvent)
 
   POINTER_PROPERTY(ClonalParasitePopulation, clinical_caused_parasite)
+  PROPERTY_REF(ul_uid, clinical_caused_parasite_uid)
 
 public:
   EndClinicalEvent();
@@ -35,6 +35,9 @@ public:
 
   virtual std::string name() = 0;
 
+  // Return true if the event may introduce parasites into the population
+  virtual bool introduces_parasites() { return false; }
+
 private:
   virtual void execute() = 0;
 };
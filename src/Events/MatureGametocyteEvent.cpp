@@ -16,7 +16,8 @@
 
 OBJECTPOOL_IMPL(MatureGametocyteEvent)
 
-MatureGametocyteEvent::MatureGametocyteEvent() : blood_parasite_(nullptr) {}
+MatureGametocyteEvent::MatureGametocyteEvent()
+    : blood_parasite_(nullptr), blood_parasite_uid_(0) {}
 
 MatureGametocyteEvent::~MatureGametocyteEvent() = default;
 
@@ -27,6 +28,7 @@ void MatureGametocyteEvent::schedule_event(
     auto* e = new MatureGametocyteEvent();
     e->dispatcher = p;
     e->set_blood_parasite(blood_parasite);
+    e->set_blood_parasite_uid(blood_parasite->get_uid());
     e->time = time;
 
     p->add(e);
@@ -36,7 +38,8 @@ void MatureGametocyteEvent::schedule_event(
 
 void MatureGametocyteEvent::execute() {
   auto* person = dynamic_cast<Person*>(dispatcher);
-  if (person->all_clonal_parasite_populations()->contain(blood_parasite_)) {
+  if (person->all_clonal_parasite_populations()->contain(
+          blood_parasite_, blood_parasite_uid_)) {
     blood_parasite_->set_gametocyte_level(
         Model::CONFIG->gametocyte_level_full());
   }
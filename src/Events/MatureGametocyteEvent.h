@@ -11,6 +11,7 @@
 #include "Core/ObjectPool.h"
 #include "Core/PropertyMacro.h"
 #include "Event.h"
+#include "Helpers/UniqueId.hxx"
 
 class ClonalParasitePopulation;
 
@@ -23,6 +24,7 @@ class MatureGametocyteEvent : public Event {
   OBJECTPOOL(MatureGametocyteEvent)
 
   POINTER_PROPERTY(ClonalParasitePopulation, blood_parasite)
+  PROPERTY_REF(ul_uid, blood_parasite_uid)
 
 public:
   MatureGametocyteEvent();
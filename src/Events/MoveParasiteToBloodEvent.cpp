@@ -61,14 +61,14 @@ void MoveParasiteToBloodEvent::execute() {
   if (person->has_effective_drug_in_blood()) {
     // person has drug in blood
     new_parasite->set_update_function(
-        Model::MODEL->having_drug_update_function());
+        ParasiteDensityUpdateFunction::HAVING_DRUG);
   } else {
     if (person->all_clonal_parasite_populations()->size() > 1) {
       if (Model::CONFIG->allow_new_coinfection_to_cause_symtoms()) {
         person->determine_clinical_or_not(new_parasite);
       } else {
         new_parasite->set_update_function(
-            Model::MODEL->immunity_clearance_update_function());
+            ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
       }
     } else {
       person->determine_clinical_or_not(new_parasite);
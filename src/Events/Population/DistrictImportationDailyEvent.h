@@ -29,6 +29,8 @@ public:
 
   std::string name() override { return "DistrictImportationDailyEvent"; }
 
+  bool introduces_parasites() override { return true; }
+
 private:
   void execute() override;
 };
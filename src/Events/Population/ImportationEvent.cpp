@@ -68,7 +68,7 @@ void ImportationEvent::execute() {
         Model::CONFIG->gametocyte_level_full());
     blood_parasite->set_last_update_log10_parasite_density(size);
     blood_parasite->set_update_function(
-        Model::MODEL->immunity_clearance_update_function());
+        ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
 
     //        Model::POPULATION->initial_infection(pi->vPerson()[0][0][ind_ac][index],
     //        Model::CONFIG->parasite_db()->get(0));
@@ -39,6 +39,8 @@ public:
 
   std::string name() override { return "ImportationEvent"; }
 
+  bool introduces_parasites() override { return true; }
+
 private:
   void execute() override;
 };
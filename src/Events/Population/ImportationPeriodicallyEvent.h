@@ -41,6 +41,8 @@ public:
 
   std::string name() override { return "ImportationPeriodicallyEvent"; }
 
+  bool introduces_parasites() override { return true; }
+
 private:
   void execute() override;
 };
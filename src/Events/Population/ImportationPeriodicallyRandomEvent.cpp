@@ -128,14 +128,14 @@ void ImportationPeriodicallyRandomEvent::infect(Person* person,
   blood_parasite->set_gametocyte_level(Model::CONFIG->gametocyte_level_full());
   blood_parasite->set_last_update_log10_parasite_density(log_parasite_density_);
   blood_parasite->set_update_function(
-      Model::MODEL->immunity_clearance_update_function());
+      ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
 
   // Check if the configured log density is equal to or greater than the
   // standard for clinical
   if (log_parasite_density_ >= Model::CONFIG->parasite_density_level()
                                    .log_parasite_density_clinical) {
     blood_parasite->set_update_function(
-        Model::MODEL->progress_to_clinical_update_function());
+        ParasiteDensityUpdateFunction::PROGRESS_TO_CLINICAL);
     person->schedule_progress_to_clinical_event_by(blood_parasite);
   }
 }
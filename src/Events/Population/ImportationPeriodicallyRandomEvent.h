@@ -43,6 +43,8 @@ public:
 
   // Return the name of this event
   std::string name() override { return EventName; }
+
+  bool introduces_parasites() override { return true; }
 };
 
 #endif
@@ -49,18 +49,23 @@ void SingleRoundMDAEvent::execute() {
     Model::RANDOM->shuffle(&all_persons_in_location[0],
                            all_persons_in_location.size(), sizeof(std::size_t));
 
+    // draw the presence and treatment day for the individuals at once
+    std::vector<double> probs(number_of_individuals_will_receive_mda);
+    std::vector<unsigned long> days(number_of_individuals_will_receive_mda);
+    Model::RANDOM->fill_uniform(probs.data(), probs.size());
+    Model::RANDOM->fill_uniform_int(days_to_complete_all_treatments,
+                                    days.data(), days.size());
+
     for (std::size_t p_i = 0; p_i < number_of_individuals_will_receive_mda;
          p_i++) {
       auto* person = all_persons_in_location[p_i];
       // step 2: determine whether person will receive treatment
-      const auto prob = Model::RANDOM->random_flat(0.0, 1.0);
-      if (prob < person->prob_present_at_mda()) {
+      if (probs[p_i] < person->prob_present_at_mda()) {
         // receive MDA
         auto* therapy =
             Model::CONFIG->therapy_db()[Model::CONFIG->mda_therapy_id()];
         // schedule received therapy in within days_to_complete_all_treatments
-        int days_to_receive_mda_therapy =
-            Model::RANDOM->random_uniform(days_to_complete_all_treatments) + 1;
+        int days_to_receive_mda_therapy = static_cast<int>(days[p_i]) + 1;
         ReceiveMDATherapyEvent::schedule_event(
             Model::SCHEDULER, person, therapy,
             Model::SCHEDULER->current_time() + days_to_receive_mda_therapy);
@@ -20,7 +20,7 @@
 OBJECTPOOL_IMPL(ProgressToClinicalEvent)
 
 ProgressToClinicalEvent::ProgressToClinicalEvent()
-    : clinical_caused_parasite_(nullptr) {}
+    : clinical_caused_parasite_(nullptr), clinical_caused_parasite_uid_(0) {}
 
 ProgressToClinicalEvent::~ProgressToClinicalEvent() = default;
 
@@ -33,13 +33,13 @@ void ProgressToClinicalEvent::execute() {
 
   // if the clinical_caused_parasite eventually removed then do nothing
   if (!person->all_clonal_parasite_populations()->contain(
-          clinical_caused_parasite_)) {
+          clinical_caused_parasite_, clinical_caused_parasite_uid_)) {
     return;
   }
 
   if (person->host_state() == Person::CLINICAL) {
     clinical_caused_parasite_->set_update_function(
-        Model::MODEL->immunity_clearance_update_function());
+        ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
     return;
   }
 
@@ -60,10 +60,10 @@ void ProgressToClinicalEvent::execute() {
   person->cancel_all_other_progress_to_clinical_events_except(this);
 
   person->change_all_parasite_update_function(
-      Model::MODEL->progress_to_clinical_update_function(),
-      Model::MODEL->immunity_clearance_update_function());
+      ParasiteDensityUpdateFunction::PROGRESS_TO_CLINICAL,
+      ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
   clinical_caused_parasite_->set_update_function(
-      Model::MODEL->clinical_update_function());
+      ParasiteDensityUpdateFunction::CLINICAL);
 
   // Statistic collect cumulative clinical episodes
   Model::MAIN_DATA_COLLECTOR->collect_1_clinical_episode(person->location(),
@@ -85,7 +85,7 @@ void ProgressToClinicalEvent::execute() {
         person->location(), person->age_class(), therapy->id());
 
     clinical_caused_parasite_->set_update_function(
-        Model::MODEL->having_drug_update_function());
+        ParasiteDensityUpdateFunction::HAVING_DRUG);
 
     // calculate EAMU
     // DEPRECATED CALL
@@ -106,7 +106,8 @@ void ProgressToClinicalEvent::execute() {
     }
 
     // The person didn't die, so schedule the remainder of the events
-    person->schedule_update_by_drug_event(clinical_caused_parasite_);
+    person->schedule_update_by_drug_event(clinical_caused_parasite_,
+                                          clinical_caused_parasite_uid_);
     person->schedule_end_clinical_event(clinical_caused_parasite_);
     person->schedule_test_treatment_failure_event(
         clinical_caused_parasite_, Model::CONFIG->tf_testing_day(),
@@ -139,6 +140,7 @@ void ProgressToClinicalEvent::schedule_event(
   auto* e = new ProgressToClinicalEvent();
   e->dispatcher = p;
   e->set_clinical_caused_parasite(clinical_caused_parasite);
+  e->set_clinical_caused_parasite_uid(clinical_caused_parasite->get_uid());
   e->time = time;
   p->add(e);
   scheduler->schedule_individual_event(e);
@@ -12,6 +12,7 @@
 #include "Core/ObjectPool.h"
 #include "Core/PropertyMacro.h"
 #include "Event.h"
+#include "Helpers/UniqueId.hxx"
 
 class Person;
 
@@ -25,6 +26,7 @@ class ProgressToClinicalEvent : public Event {
   DELETE_COPY_AND_MOVE(ProgressToClinicalEvent)
 
   POINTER_PROPERTY(ClonalParasitePopulation, clinical_caused_parasite)
+  PROPERTY_REF(ul_uid, clinical_caused_parasite_uid)
 
 public:
   ProgressToClinicalEvent();
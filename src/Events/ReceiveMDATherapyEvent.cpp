@@ -39,8 +39,8 @@ void ReceiveMDATherapyEvent::execute() {
   // if this person has progress to clinical event then cancel it
   person->cancel_all_other_progress_to_clinical_events_except(nullptr);
   person->change_all_parasite_update_function(
-      Model::MODEL->progress_to_clinical_update_function(),
-      Model::MODEL->immunity_clearance_update_function());
+      ParasiteDensityUpdateFunction::PROGRESS_TO_CLINICAL,
+      ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
 
-  person->schedule_update_by_drug_event(nullptr);
+  person->schedule_update_by_drug_event(nullptr, 0);
 }
@@ -14,6 +14,7 @@
 ReceiveTherapyEvent::ReceiveTherapyEvent()
     : received_therapy_(nullptr),
       clinical_caused_parasite_(nullptr),
+      clinical_caused_parasite_uid_(0),
       is_mac_therapy_(false) {}
 
 ReceiveTherapyEvent::~ReceiveTherapyEvent() = default;
@@ -29,6 +30,10 @@ void ReceiveTherapyEvent::schedule_event(
     e->set_received_therapy(therapy);
     e->time = time;
     e->set_clinical_caused_parasite(clinical_caused_parasite);
+    e->set_clinical_caused_parasite_uid(
+        clinical_caused_parasite == nullptr
+            ? 0
+            : clinical_caused_parasite->get_uid());
     e->set_is_mac_therapy(is_mac_therapy);
 
     // Schedule it for the individual
@@ -41,5 +46,6 @@ void ReceiveTherapyEvent::execute() {
   auto* person = dynamic_cast<Person*>(dispatcher);
   person->receive_therapy(received_therapy_, clinical_caused_parasite_,
                           is_mac_therapy_);
-  person->schedule_update_by_drug_event(clinical_caused_parasite_);
+  person->schedule_update_by_drug_event(clinical_caused_parasite_,
+                                        clinical_caused_parasite_uid_);
 }
@@ -8,6 +8,7 @@
 #define RECEIVETHERAPYEVENT_H
 
 #include "Event.h"
+#include "Helpers/UniqueId.hxx"
 #include "Population/ClonalParasitePopulation.h"
 
 class Scheduler;
@@ -24,6 +25,7 @@ class ReceiveTherapyEvent : public Event {
   POINTER_PROPERTY(Therapy, received_therapy)
 
   POINTER_PROPERTY(ClonalParasitePopulation, clinical_caused_parasite)
+  PROPERTY_REF(ul_uid, clinical_caused_parasite_uid)
 
   PROPERTY_REF(bool, is_mac_therapy)
 
@@ -16,7 +16,9 @@
 OBJECTPOOL_IMPL(TestTreatmentFailureEvent)
 
 TestTreatmentFailureEvent::TestTreatmentFailureEvent()
-    : clinical_caused_parasite_(nullptr), therapyId_(0) {}
+    : clinical_caused_parasite_(nullptr),
+      clinical_caused_parasite_uid_(0),
+      therapyId_(0) {}
 
 void TestTreatmentFailureEvent::schedule_event(
     Scheduler* scheduler, Person* p,
@@ -29,6 +31,7 @@ void TestTreatmentFailureEvent::schedule_event(
   auto* e = new TestTreatmentFailureEvent();
   e->dispatcher = p;
   e->set_clinical_caused_parasite(clinical_caused_parasite);
+  e->set_clinical_caused_parasite_uid(clinical_caused_parasite->get_uid());
   e->time = time;
   e->set_therapyId(t_id);
   p->add(e);
@@ -41,7 +44,7 @@ void TestTreatmentFailureEvent::execute() {
   // If the parasite is still present at a detectable level, then it's a
   // treatment failure
   if (person->all_clonal_parasite_populations()->contain(
-          clinical_caused_parasite())
+          clinical_caused_parasite_, clinical_caused_parasite_uid_)
       && clinical_caused_parasite_->last_update_log10_parasite_density()
              > Model::CONFIG->parasite_density_level()
                    .log_parasite_density_detectable) {
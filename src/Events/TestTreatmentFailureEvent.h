@@ -10,6 +10,7 @@
 #include "Core/ObjectPool.h"
 #include "Core/PropertyMacro.h"
 #include "Event.h"
+#include "Helpers/UniqueId.hxx"
 
 class ClonalParasitePopulation;
 
@@ -21,6 +22,7 @@ class TestTreatmentFailureEvent : public Event {
   DELETE_COPY_AND_MOVE(TestTreatmentFailureEvent)
   OBJECTPOOL(TestTreatmentFailureEvent)
   POINTER_PROPERTY(ClonalParasitePopulation, clinical_caused_parasite)
+  PROPERTY_REF(ul_uid, clinical_caused_parasite_uid)
   PROPERTY_REF(int, therapyId)
 
 public:
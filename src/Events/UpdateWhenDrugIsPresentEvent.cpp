@@ -18,17 +18,19 @@
 OBJECTPOOL_IMPL(UpdateWhenDrugIsPresentEvent)
 
 UpdateWhenDrugIsPresentEvent::UpdateWhenDrugIsPresentEvent()
-    : clinical_caused_parasite_(nullptr) {}
+    : clinical_caused_parasite_(nullptr), clinical_caused_parasite_uid_(0) {}
 
 UpdateWhenDrugIsPresentEvent::~UpdateWhenDrugIsPresentEvent() = default;
 
 void UpdateWhenDrugIsPresentEvent::schedule_event(
     Scheduler* scheduler, Person* p,
-    ClonalParasitePopulation* clinical_caused_parasite, const int &time) {
+    ClonalParasitePopulation* clinical_caused_parasite,
+    const ul_uid &clinical_caused_parasite_uid, const int &time) {
   if (scheduler != nullptr) {
     auto* e = new UpdateWhenDrugIsPresentEvent();
     e->dispatcher = p;
     e->set_clinical_caused_parasite(clinical_caused_parasite);
+    e->set_clinical_caused_parasite_uid(clinical_caused_parasite_uid);
     e->time = time;
 
     p->add(e);
@@ -40,7 +42,7 @@ void UpdateWhenDrugIsPresentEvent::execute() {
   auto* person = dynamic_cast<Person*>(dispatcher);
   if (person->drugs_in_blood()->size() > 0) {
     if (person->all_clonal_parasite_populations()->contain(
-            clinical_caused_parasite_)
+            clinical_caused_parasite_, clinical_caused_parasite_uid_)
         && person->host_state() == Person::CLINICAL) {
       if (clinical_caused_parasite_->last_update_log10_parasite_density()
           <= Model::CONFIG->parasite_density_level()
@@ -48,7 +50,8 @@ void UpdateWhenDrugIsPresentEvent::execute() {
         person->set_host_state(Person::ASYMPTOMATIC);
       }
     }
-    person->schedule_update_by_drug_event(clinical_caused_parasite_);
+    person->schedule_update_by_drug_event(clinical_caused_parasite_,
+                                          clinical_caused_parasite_uid_);
   } else {
     //        no drug in blood, reset the status of drug Update parasite
     // the drug update parasite is inserted into blood when  there is still drug
@@ -59,8 +62,9 @@ void UpdateWhenDrugIsPresentEvent::execute() {
       const auto blood_parasite =
           person->all_clonal_parasite_populations()->parasites()->at(i);
       if (blood_parasite->update_function()
-          == Model::MODEL->having_drug_update_function()) {
-        person->determine_relapse_or_not(blood_parasite);
+          == ParasiteDensityUpdateFunction::HAVING_DRUG) {
+        person->determine_relapse_or_not(blood_parasite,
+                                         blood_parasite->get_uid());
       }
     }
   }
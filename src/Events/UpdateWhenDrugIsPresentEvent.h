@@ -13,6 +13,7 @@
 #include "Core/ObjectPool.h"
 #include "Core/PropertyMacro.h"
 #include "Event.h"
+#include "Helpers/UniqueId.hxx"
 
 class ClonalParasitePopulation;
 
@@ -26,6 +27,7 @@ class UpdateWhenDrugIsPresentEvent : public Event {
   OBJECTPOOL(UpdateWhenDrugIsPresentEvent)
 
   POINTER_PROPERTY(ClonalParasitePopulation, clinical_caused_parasite)
+  PROPERTY_REF(ul_uid, clinical_caused_parasite_uid)
 
 public:
   UpdateWhenDrugIsPresentEvent();
@@ -33,8 +35,11 @@ public:
   //    UpdateByHavingDrugEvent(const UpdateByHavingDrugEvent& orig);
   virtual ~UpdateWhenDrugIsPresentEvent();
 
+  // The uid is passed separately since the event reschedules itself after
+  // the clone may have been cleared
   static void schedule_event(Scheduler* scheduler, Person* p,
                              ClonalParasitePopulation* clinical_caused_parasite,
+                             const ul_uid &clinical_caused_parasite_uid,
                              const int &time);
 
   std::string name() override { return "UpdateByHavingDrugEvent"; }
@@ -71,25 +71,9 @@ bool SpatialData::check_catalog(std::string &errors) {
 }
 
 void SpatialData::generate_distances() const {
-  auto &db = Model::CONFIG->location_db();
-  auto &distances = Model::CONFIG->spatial_distance_matrix();
-
-  auto locations = db.size();
-  distances.resize(static_cast<unsigned long>(locations));
-  for (std::size_t from = 0; from < locations; from++) {
-    distances[from].resize(static_cast<unsigned long long int>(locations));
-    for (std::size_t to = 0; to < locations; to++) {
-      distances[from][to] =
-          std::sqrt(std::pow(cell_size
-                                 * (db[from].coordinate->latitude
-                                    - db[to].coordinate->latitude),
-                             2)
-                    + std::pow(cell_size
-                                   * (db[from].coordinate->longitude
-                                      - db[to].coordinate->longitude),
-                               2));
-    }
-  }
+  Model::CONFIG->spatial_distance_matrix() =
+      Spatial::DistanceMatrix::from_raster(Model::CONFIG->location_db(),
+                                           cell_size);
 
   VLOG(1) << "Updated Euclidean distances using raster data";
 }
@@ -0,0 +1,97 @@
+/*
+ * LookupTables.hxx
+ *
+ * This pseudo-library defines precomputed lookup tables that are used in place
+ * of transcendental functions that are evaluated for each individual in hot
+ * code paths (e.g., the immune response), where the inputs are fixed once the
+ * configuration is loaded.
+ */
+#ifndef LOOKUP_TABLES_HXX
+#define LOOKUP_TABLES_HXX
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Table of exp(-rate * duration) for integer durations. The duration is split
+// as (high * LOW_SIZE + low) so that two small tables cover DURATION_LIMIT days
+// at the cost of one multiplication, the result is within a couple of ULPs of
+// calling exp directly. Durations past the limit fall back to exp.
+class ExponentialDecayTable {
+public:
+  static constexpr int LOW_BITS = 6;
+  static constexpr int LOW_SIZE = 1 << LOW_BITS;
+  static constexpr int HIGH_SIZE = 64;
+  static constexpr int DURATION_LIMIT = LOW_SIZE * HIGH_SIZE;
+
+private:
+  double rate_{0.0};
+  std::vector<double> low_;
+  std::vector<double> high_;
+
+public:
+  ExponentialDecayTable() = default;
+
+  explicit ExponentialDecayTable(double rate) : rate_(rate) {
+    low_.resize(LOW_SIZE);
+    high_.resize(HIGH_SIZE);
+    for (auto ndx = 0; ndx < LOW_SIZE; ndx++) {
+      low_[ndx] = std::exp(-rate * ndx);
+    }
+    for (auto ndx = 0; ndx < HIGH_SIZE; ndx++) {
+      high_[ndx] = std::exp(-rate * ndx * LOW_SIZE);
+    }
+  }
+
+  [[nodiscard]] double rate() const { return rate_; }
+
+  // Return exp(-rate * duration), the duration must not be negative
+  [[nodiscard]] double operator()(int duration) const {
+    if (duration >= DURATION_LIMIT || low_.empty()) {
+      return std::exp(-rate_ * duration);
+    }
+    return high_[duration >> LOW_BITS] * low_[duration & (LOW_SIZE - 1)];
+  }
+};
+
+// Table of a smooth function sampled at evenly spaced points over [min, max]
+// that is evaluated using linear interpolation. Inputs outside of the range are
+// clamped to it, evaluating a default constructed (empty) table throws.
+class InterpolationTable {
+private:
+  double min_{0.0};
+  double max_{0.0};
+  double scale_{0.0};
+  std::vector<double> values_;
+
+public:
+  InterpolationTable() = default;
+
+  template <typename Function>
+  InterpolationTable(double min, double max, int intervals, Function function)
+      : min_(min), max_(max), scale_(intervals / (max - min)) {
+    values_.resize(intervals + 1);
+    for (auto ndx = 0; ndx <= intervals; ndx++) {
+      values_[ndx] = function(min + (max - min) * ndx / intervals);
+    }
+  }
+
+  [[nodiscard]] bool empty() const { return values_.empty(); }
+
+  [[nodiscard]] double operator()(double x) const {
+    if (values_.empty()) {
+      throw std::logic_error(
+          "InterpolationTable evaluated before it was built");
+    }
+    if (x <= min_) { return values_.front(); }
+    if (x >= max_) { return values_.back(); }
+    const auto position = (x - min_) * scale_;
+    auto ndx = static_cast<std::size_t>(position);
+    if (ndx >= values_.size() - 1) { ndx = values_.size() - 2; }
+    const auto fraction = position - ndx;
+    return values_[ndx] + fraction * (values_[ndx + 1] - values_[ndx]);
+  }
+};
+
+#endif
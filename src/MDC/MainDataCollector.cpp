@@ -11,12 +11,14 @@
 
 #include "Constants.h"
 #include "Core/Config/Config.h"
+#include "Core/ThreadPool.h"
 #include "Model.h"
 #include "Population/ImmuneSystem.h"
 #include "Population/Person.h"
 #include "Population/Population.h"
 #include "Population/Properties/PersonIndexByLocationStateAgeClass.h"
 #include "Therapies/SCTherapy.h"
+#include "easylogging++.h"
 
 #define Vector_by_Locations(template) \
   template(Model::CONFIG->number_of_locations(), 0)
@@ -58,6 +60,11 @@ void MainDataCollector::initialize() {
   malaria_deaths_by_location_age_class_ = IntMatrix_Locations_by_AgeClasses();
 
   popsize_residence_by_location_ = Vector_by_Locations(IntVector);
+  residents_by_location_ = Vector_by_Locations(IntVector);
+  popsize_by_location_hoststate_age_by_5_ = IntVector3(
+      Model::CONFIG->number_of_locations(),
+      IntVector2(Person::NUMBER_OF_STATE,
+                 IntVector(NUMBER_OF_AGE_GROUPS_BY_5, 0)));
 
   blood_slide_prevalence_by_location_ = Vector_by_Locations(DoubleVector);
   blood_slide_prevalence_by_location_age_group_ =
@@ -177,126 +184,244 @@ void MainDataCollector::perform_population_statistic() {
   // Start by zeroing out the population statistics from the previous month
   zero_population_statistics();
 
+#ifdef DEBUG
+  verify_population_count();
+#endif
+
+  // The residents are counted as the population changes, but the movement
+  // model only sees the count as of the last statistic
+  popsize_residence_by_location_ = residents_by_location_;
+
+  // Each location only writes its own entries and visits its individuals in
+  // the same order as a serial loop, so the results do not depend on the
+  // number of threads
+  Model::THREAD_POOL->parallel_for(
+      static_cast<std::size_t>(Model::CONFIG->number_of_locations()),
+      STATISTIC_GRAIN, [this](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto loc = begin; loc < end; loc++) {
+          perform_location_statistic(static_cast<int>(loc));
+        }
+      });
+}
+
+void MainDataCollector::perform_location_statistic(int loc) {
   // Get the pointer to work with
   auto* pi =
       Model::POPULATION->get_person_index<PersonIndexByLocationStateAgeClass>();
 
-  for (auto loc = 0; loc < Model::CONFIG->number_of_locations(); loc++) {
-    // Calculate the basic statistics for the population in this location
-    for (auto hs = 0; hs < Person::NUMBER_OF_STATE - 1; hs++) {
-      for (auto ac = 0ul; ac < Model::CONFIG->number_of_age_classes(); ac++) {
-        std::size_t size = pi->vPerson()[loc][hs][ac].size();
+  // Calculate the basic statistics for the population in this location from
+  // the size of the index and the maintained counts
+  for (auto hs = 0; hs < Person::NUMBER_OF_STATE - 1; hs++) {
+    for (auto ac = 0ul; ac < Model::CONFIG->number_of_age_classes(); ac++) {
+      auto size = static_cast<int>(pi->vPerson()[loc][hs][ac].size());
 
-        popsize_by_location_hoststate_[loc][hs] += static_cast<int>(size);
-        popsize_by_location_age_class_[loc][ac] += static_cast<int>(size);
+      popsize_by_location_hoststate_[loc][hs] += size;
+      popsize_by_location_age_class_[loc][ac] += size;
 
-        for (std::size_t i = 0; i < size; i++) {
-          Person* p = pi->vPerson()[loc][hs][ac][i];
-          popsize_residence_by_location_[p->residence_location()]++;
+      if (hs == Person::ASYMPTOMATIC || hs == Person::CLINICAL) {
+        number_of_positive_by_location_[loc] += size;
+        number_of_positive_by_location_age_group_[loc][ac] += size;
+      }
+      if (hs == Person::CLINICAL) {
+        blood_slide_prevalence_by_location_[loc] += size;
+        blood_slide_number_by_location_age_group_[loc][ac] += size;
+        number_of_clinical_by_location_age_group_[loc][ac] += size;
+      }
+    }
 
-          // this immune value will include maternal immunity value of the
-          // infants
-          double immune_value = p->immune_system()->get_latest_immune_value();
-          total_immune_by_location_[loc] += immune_value;
-          total_immune_by_location_age_class_[loc][ac] += immune_value;
+    for (auto ac1 = 0; ac1 < NUMBER_OF_AGE_GROUPS_BY_5; ac1++) {
+      auto count = popsize_by_location_hoststate_age_by_5_[loc][hs][ac1];
+      popsize_by_location_age_class_by_5_[loc][ac1] += count;
+      if (hs == Person::CLINICAL) {
+        blood_slide_number_by_location_age_group_by_5_[loc][ac1] += count;
+        number_of_clinical_by_location_age_group_by_5_[loc][ac1] += count;
+      }
+    }
+  }
 
-          int ac1 = (p->age() > 70) ? 14 : p->age() / 5;
-          popsize_by_location_age_class_by_5_[loc][ac1] += 1;
+  // Detectable parasites and the multiple of infection (MOI) depend on the
+  // parasite density, so the infected individuals still need to be visited
+  for (auto hs = static_cast<int>(Person::EXPOSED); hs <= Person::CLINICAL;
+       hs++) {
+    for (auto ac = 0ul; ac < Model::CONFIG->number_of_age_classes(); ac++) {
+      for (auto* p : pi->vPerson()[loc][hs][ac]) {
+        if (hs == Person::ASYMPTOMATIC && p->has_detectable_parasite()) {
+          blood_slide_prevalence_by_location_[loc] += 1;
+          blood_slide_number_by_location_age_group_[loc][ac] += 1;
+          blood_slide_number_by_location_age_group_by_5_
+              [loc][age_group_by_5(p->age())] += 1;
+        }
 
-          if (hs == Person::ASYMPTOMATIC) {
-            number_of_positive_by_location_[loc]++;
-            number_of_positive_by_location_age_group_[loc][ac] += 1;
+        int moi = p->all_clonal_parasite_populations()->size();
+        if (moi > 0) {
+          total_parasite_population_by_location_[loc] += moi;
+          total_parasite_population_by_location_age_group_[loc]
+                                                          [p->age_class()] +=
+              moi;
+          if (moi <= NUMBER_OF_REPORTED_MOI) {
+            multiple_of_infection_by_location_[loc][moi - 1]++;
+          }
+        }
+      }
+    }
+  }
 
-            if (p->has_detectable_parasite()) {
-              blood_slide_prevalence_by_location_[loc] += 1;
-              blood_slide_number_by_location_age_group_[loc][ac] += 1;
-              blood_slide_number_by_location_age_group_by_5_[loc][ac1] += 1;
-            }
+  fraction_of_positive_that_are_clinical_by_location_[loc] =
+      (blood_slide_prevalence_by_location_[loc] == 0)
+          ? 0
+          : static_cast<double>(
+                popsize_by_location_hoststate_[loc][Person::CLINICAL])
+                / blood_slide_prevalence_by_location_[loc];
+
+  auto location_population = static_cast<double>(Model::POPULATION->size(loc));
+  const auto number_of_blood_slide_positive =
+      blood_slide_prevalence_by_location_[loc];
+  blood_slide_prevalence_by_location_[loc] =
+      blood_slide_prevalence_by_location_[loc] / location_population;
+
+  current_EIR_by_location_[loc] =
+      static_cast<double>(
+          total_number_of_bites_by_location_[loc]
+          - last_update_total_number_of_bites_by_location_[loc])
+      / location_population;
+
+  last_update_total_number_of_bites_by_location_[loc] =
+      total_number_of_bites_by_location_[loc];
+
+  auto report_index =
+      (Model::SCHEDULER->current_time() / Model::CONFIG->report_frequency())
+      % 10;
+  last_10_blood_slide_prevalence_by_location_[loc][report_index] =
+      blood_slide_prevalence_by_location_[loc];
+  last_10_fraction_positive_that_are_clinical_by_location_[loc][report_index] =
+      fraction_of_positive_that_are_clinical_by_location_[loc];
+
+  for (std::size_t ac = 0; ac < Model::CONFIG->number_of_age_classes(); ac++) {
+    last_10_fraction_positive_that_are_clinical_by_location_age_class_
+        [loc][ac][report_index] =
+            (blood_slide_prevalence_by_location_age_group_[loc][ac] == 0)
+                ? 0
+                : number_of_clinical_by_location_age_group_[loc][ac]
+                      / static_cast<double>(
+                          blood_slide_prevalence_by_location_age_group_[loc]
+                                                                       [ac]);
+
+    last_10_fraction_positive_that_are_clinical_by_location_age_class_by_5_
+        [loc][ac][report_index] =
+            (number_of_blood_slide_positive == 0)
+                ? 0
+                : number_of_clinical_by_location_age_group_by_5_[loc][ac]
+                      / number_of_blood_slide_positive;
+
+    blood_slide_prevalence_by_location_age_group_[loc][ac] =
+        blood_slide_number_by_location_age_group_[loc][ac]
+        / static_cast<double>(popsize_by_location_age_class_[loc][ac]);
+    blood_slide_prevalence_by_location_age_group_by_5_[loc][ac] =
+        blood_slide_number_by_location_age_group_by_5_[loc][ac]
+        / static_cast<double>(popsize_by_location_age_class_by_5_[loc][ac]);
+  }
+}
 
-          } else if (hs == Person::CLINICAL) {
-            number_of_positive_by_location_[loc]++;
-            number_of_positive_by_location_age_group_[loc][ac] += 1;
-            blood_slide_prevalence_by_location_[loc] += 1;
-            blood_slide_number_by_location_age_group_[loc][ac] += 1;
-            blood_slide_number_by_location_age_group_by_5_[loc][ac1] += 1;
-            number_of_clinical_by_location_age_group_[loc][ac] += 1;
-            number_of_clinical_by_location_age_group_by_5_[loc][ac1] += 1;
-          }
+void MainDataCollector::perform_immune_statistic() {
+  zero_fill(total_immune_by_location_);
+  for (auto &immune : total_immune_by_location_age_class_) {
+    zero_fill(immune);
+  }
+
+  // While the updates are deferred the latest value may be long out of date,
+  // so the value is evaluated as of the last update the individual would have
+  // had, which keeps the statistic the same as a run without fast forwarding
+  const auto fast_forward = Model::SCHEDULER->fast_forward();
 
-          // Calculate the multiple of infection (MOI)
-          int moi = p->all_clonal_parasite_populations()->size();
-          if (moi > 0) {
-            total_parasite_population_by_location_[loc] += moi;
-            total_parasite_population_by_location_age_group_[loc]
-                                                            [p->age_class()] +=
-                moi;
-            if (moi <= NUMBER_OF_REPORTED_MOI) {
-              multiple_of_infection_by_location_[loc][moi - 1]++;
+  // As with the population statistic the locations are summed independently
+  auto* pi =
+      Model::POPULATION->get_person_index<PersonIndexByLocationStateAgeClass>();
+  Model::THREAD_POOL->parallel_for(
+      static_cast<std::size_t>(Model::CONFIG->number_of_locations()),
+      STATISTIC_GRAIN, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto loc = begin; loc < end; loc++) {
+          for (auto hs = 0; hs < Person::NUMBER_OF_STATE - 1; hs++) {
+            for (auto ac = 0ul; ac < Model::CONFIG->number_of_age_classes();
+                 ac++) {
+              for (auto* p : pi->vPerson()[loc][hs][ac]) {
+                // this immune value will include maternal immunity value of
+                // the infants
+                double immune_value =
+                    p->immune_system()->get_latest_immune_value();
+                if (fast_forward) {
+                  const auto update_time = p->last_periodic_update_time();
+                  if (update_time > p->latest_update_time()) {
+                    immune_value =
+                        p->immune_system()->get_value_at(update_time);
+                  }
+                }
+                total_immune_by_location_[loc] += immune_value;
+                total_immune_by_location_age_class_[loc][ac] += immune_value;
+              }
             }
           }
         }
+      });
+}
+
+void MainDataCollector::update_population_count(int location, int host_state,
+                                                int age, int residence,
+                                                int delta) {
+  popsize_by_location_hoststate_age_by_5_[location][host_state]
+                                         [age_group_by_5(age)] += delta;
+  if (host_state != Person::DEAD) {
+    residents_by_location_[residence] += delta;
+  }
+}
+
+void MainDataCollector::record_person_added(Person* person) {
+  update_population_count(person->location(), person->host_state(),
+                          person->age(), person->residence_location(), 1);
+}
+
+void MainDataCollector::record_person_removed(Person* person) {
+  update_population_count(person->location(), person->host_state(),
+                          person->age(), person->residence_location(), -1);
+}
+
+void MainDataCollector::record_person_changed(Person* person, int location,
+                                              int host_state, int age) {
+  record_person_removed(person);
+  update_population_count(location, host_state, age,
+                          person->residence_location(), 1);
+}
+
+#ifdef DEBUG
+void MainDataCollector::verify_population_count() {
+  auto counts = popsize_by_location_hoststate_age_by_5_;
+  auto residents = residents_by_location_;
+
+  auto* pi =
+      Model::POPULATION->get_person_index<PersonIndexByLocationStateAgeClass>();
+  for (auto loc = 0; loc < Model::CONFIG->number_of_locations(); loc++) {
+    for (auto hs = 0; hs < Person::NUMBER_OF_STATE; hs++) {
+      for (auto ac = 0ul; ac < Model::CONFIG->number_of_age_classes(); ac++) {
+        for (auto* p : pi->vPerson()[loc][hs][ac]) {
+          counts[loc][hs][age_group_by_5(p->age())]--;
+          if (hs != Person::DEAD) { residents[p->residence_location()]--; }
+        }
       }
     }
+  }
 
-    fraction_of_positive_that_are_clinical_by_location_[loc] =
-        (blood_slide_prevalence_by_location_[loc] == 0)
-            ? 0
-            : static_cast<double>(
-                  popsize_by_location_hoststate_[loc][Person::CLINICAL])
-                  / blood_slide_prevalence_by_location_[loc];
-
-    auto location_population =
-        static_cast<double>(Model::POPULATION->size(loc));
-    const auto number_of_blood_slide_positive =
-        blood_slide_prevalence_by_location_[loc];
-    blood_slide_prevalence_by_location_[loc] =
-        blood_slide_prevalence_by_location_[loc] / location_population;
-
-    current_EIR_by_location_[loc] =
-        static_cast<double>(
-            total_number_of_bites_by_location_[loc]
-            - last_update_total_number_of_bites_by_location_[loc])
-        / location_population;
-
-    last_update_total_number_of_bites_by_location_[loc] =
-        total_number_of_bites_by_location_[loc];
-
-    auto report_index =
-        (Model::SCHEDULER->current_time() / Model::CONFIG->report_frequency())
-        % 10;
-    last_10_blood_slide_prevalence_by_location_[loc][report_index] =
-        blood_slide_prevalence_by_location_[loc];
-    last_10_fraction_positive_that_are_clinical_by_location_
-        [loc][report_index] =
-            fraction_of_positive_that_are_clinical_by_location_[loc];
-
-    for (std::size_t ac = 0; ac < Model::CONFIG->number_of_age_classes();
-         ac++) {
-      last_10_fraction_positive_that_are_clinical_by_location_age_class_
-          [loc][ac][report_index] =
-              (blood_slide_prevalence_by_location_age_group_[loc][ac] == 0)
-                  ? 0
-                  : number_of_clinical_by_location_age_group_[loc][ac]
-                        / static_cast<double>(
-                            blood_slide_prevalence_by_location_age_group_[loc]
-                                                                         [ac]);
-
-      last_10_fraction_positive_that_are_clinical_by_location_age_class_by_5_
-          [loc][ac][report_index] =
-              (number_of_blood_slide_positive == 0)
-                  ? 0
-                  : number_of_clinical_by_location_age_group_by_5_[loc][ac]
-                        / number_of_blood_slide_positive;
-
-      blood_slide_prevalence_by_location_age_group_[loc][ac] =
-          blood_slide_number_by_location_age_group_[loc][ac]
-          / static_cast<double>(popsize_by_location_age_class_[loc][ac]);
-      blood_slide_prevalence_by_location_age_group_by_5_[loc][ac] =
-          blood_slide_number_by_location_age_group_by_5_[loc][ac]
-          / static_cast<double>(popsize_by_location_age_class_by_5_[loc][ac]);
+  for (auto loc = 0; loc < Model::CONFIG->number_of_locations(); loc++) {
+    LOG_IF(residents[loc] != 0, FATAL)
+        << "Resident count differs from the population at location " << loc;
+    for (const auto &by_age : counts[loc]) {
+      LOG_IF(std::any_of(by_age.begin(), by_age.end(),
+                         [](int count) { return count != 0; }),
+             FATAL)
+          << "Population count differs from the population at location "
+          << loc;
     }
   }
 }
+#endif
 
 void MainDataCollector::collect_number_of_bites(const int &location,
                                                 const int &number_of_bites) {
@@ -683,10 +808,8 @@ void MainDataCollector::monthly_update() {
 
 void MainDataCollector::zero_population_statistics() {
   // Vectors to be zeroed
-  zero_fill(popsize_residence_by_location_);
   zero_fill(blood_slide_prevalence_by_location_);
   zero_fill(fraction_of_positive_that_are_clinical_by_location_);
-  zero_fill(total_immune_by_location_);
   zero_fill(total_parasite_population_by_location_);
   zero_fill(number_of_positive_by_location_);
 
@@ -694,7 +817,6 @@ void MainDataCollector::zero_population_statistics() {
   for (auto location = 0ul; location < Model::CONFIG->number_of_locations();
        location++) {
     zero_fill(popsize_by_location_hoststate_[location]);
-    zero_fill(total_immune_by_location_age_class_[location]);
     zero_fill(total_parasite_population_by_location_age_group_[location]);
     zero_fill(number_of_positive_by_location_age_group_[location]);
     zero_fill(number_of_clinical_by_location_age_group_[location]);
@@ -202,14 +202,40 @@ private:
   void update_average_number_bitten(const int &location, const int &birthday,
                                     const int &number_of_times_bitten);
 
+  // Count of the individuals by location, host state, and age group by 5,
+  // along with the count of the living individuals by residence location.
+  // These are maintained as the population changes so that the monthly
+  // statistic does not need to visit every individual.
+  IntVector3 popsize_by_location_hoststate_age_by_5_;
+  IntVector residents_by_location_;
+
+  // Number of locations in each chunk of the parallel statistics
+  static constexpr std::size_t STATISTIC_GRAIN = 64;
+
   // Zero out the population statistics tracked by
   // perform_population_statistic()
   void zero_population_statistics();
 
+  // Calculate the population statistics for one location
+  void perform_location_statistic(int loc);
+
+  void update_population_count(int location, int host_state, int age,
+                               int residence, int delta);
+
+#ifdef DEBUG
+  // Compare the maintained counts against a full scan of the population
+  void verify_population_count();
+#endif
+
 public:
   // The number of reported multiple of infection (MOI)
   static const int NUMBER_OF_REPORTED_MOI = 8;
 
+  // The number of age groups by 5, the last group is everyone over 70
+  static const int NUMBER_OF_AGE_GROUPS_BY_5 = 15;
+
+  static int age_group_by_5(int age) { return (age > 70) ? 14 : age / 5; }
+
   explicit MainDataCollector(Model* model = nullptr);
 
   virtual ~MainDataCollector() = default;
@@ -218,6 +244,19 @@ public:
 
   void perform_population_statistic();
 
+  // Calculate the total immune value by location and age class, this visits
+  // every individual so it is left to the reporters that use it
+  void perform_immune_statistic();
+
+  // Update the population counts when an individual is added or removed
+  void record_person_added(Person* person);
+  void record_person_removed(Person* person);
+
+  // Update the population counts before the location, host state, or age of
+  // an individual changes to the values given
+  void record_person_changed(Person* person, int location, int host_state,
+                             int age);
+
   void yearly_update();
 
   // Reset monthly tracking variables after the reporters had a chance to access
@@ -144,6 +144,11 @@ void handle_cli(Model* model, int argc, char** argv, int &job_number,
   args::Flag district_movement(
       commands, "md",
       "Record the movement between districts, cannot run with --mc", {"md"});
+  args::ValueFlag<double> movement_sampling(
+      commands, "float",
+      "Fraction of individuals whose movement is recorded, default 1.0 \nEx: "
+      "MaSim --ms 0.1",
+      {"ms"});
   args::Flag load_genotypes(
       commands, "load", "Load the genotypes to the database", {'l', "load"});
 
@@ -174,6 +179,13 @@ void handle_cli(Model* model, int argc, char** argv, int &job_number,
                    "together.\n";
       exit(EXIT_FAILURE);
     }
+
+    // Check that the movement sampling rate is a valid fraction
+    if (movement_sampling && (args::get(movement_sampling) <= 0
+                              || args::get(movement_sampling) > 1)) {
+      std::cerr << "--ms must be greater than zero and at most one.\n";
+      exit(EXIT_FAILURE);
+    }
   } catch (const args::Help &e) {
     std::cout << "MaSim v. " << VERSION << std::endl;
     std::cout << e.what() << parser;
@@ -251,4 +263,6 @@ void handle_cli(Model* model, int argc, char** argv, int &job_number,
   model->set_individual_movement(individual_movement);
   model->set_cell_movement(cell_movement);
   model->set_district_movement(district_movement);
+  model->set_movement_sampling_rate(
+      movement_sampling ? args::get(movement_sampling) : 1.0);
 }
@@ -8,8 +8,11 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 #include "Core/Config/Config.h"
 #include "Core/Random.h"
+#include "Core/ThreadPool.h"
 #include "Events/BirthdayEvent.h"
 #include "Events/CirculateToTargetLocationNextDayEvent.h"
 #include "Events/EndClinicalByNoTreatmentEvent.h"
@@ -29,6 +32,7 @@
 #include "Helpers/StringHelpers.h"
 #include "MDC/MainDataCollector.h"
 #include "Population/ClonalParasitePopulation.h"
+#include "Population/DrugsInBlood.h"
 #include "Population/ImmuneSystem.h"
 #include "Population/Person.h"
 #include "Population/Population.h"
@@ -36,7 +40,6 @@
 #include "Reporters/Reporter.h"
 #include "Spatial/SpatialModel.hxx"
 #include "Strategies/IStrategy.h"
-#include "Therapies/Drug.h"
 #include "Treatment/SteadyTCM.hxx"
 #include "Validation/MovementValidation.h"
 #include "easylogging++.h"
@@ -47,12 +50,14 @@ Random* Model::RANDOM = nullptr;
 Scheduler* Model::SCHEDULER = nullptr;
 MainDataCollector* Model::MAIN_DATA_COLLECTOR = nullptr;
 Population* Model::POPULATION = nullptr;
+ThreadPool* Model::THREAD_POOL = nullptr;
 IStrategy* Model::TREATMENT_STRATEGY = nullptr;
 ITreatmentCoverageModel* Model::TREATMENT_COVERAGE = nullptr;
 
 Model::Model(const int &object_pool_size) {
   initialize_object_pool(object_pool_size);
   random_ = new Random();
+  thread_pool_ = nullptr;
   config_ = new Config(this);
   scheduler_ = new Scheduler(this);
   population_ = new Population(this);
@@ -65,12 +70,6 @@ Model::Model(const int &object_pool_size) {
   MAIN_DATA_COLLECTOR = data_collector_;
   POPULATION = population_;
 
-  progress_to_clinical_update_function_ = new ClinicalUpdateFunction(this);
-  immunity_clearance_update_function_ =
-      new ImmunityClearanceUpdateFunction(this);
-  having_drug_update_function_ = new ImmunityClearanceUpdateFunction(this);
-  clinical_update_function_ = new ImmunityClearanceUpdateFunction(this);
-
   reporters_ = std::vector<Reporter*>();
 
   config_filename_ = "config.yml";
@@ -80,6 +79,7 @@ Model::Model(const int &object_pool_size) {
   gui_type_ = -1;
   is_farm_output_ = false;
   cluster_job_number_ = 0;
+  movement_sampling_rate_ = 1.0;
   reporter_type_ = "";
 }
 
@@ -140,7 +140,12 @@ void Model::initialize(int job_number, const std::string &path) {
   }
 
   VLOG(1) << "Initialize Random";
-  random_->initialize(config_->initial_seed_number());
+  random_->initialize(config_->initial_seed_number(),
+                      config_->legacy_random_number_generator());
+
+  VLOG(1) << "Initialize ThreadPool";
+  thread_pool_ = new ThreadPool(std::max(config_->number_of_threads(), 1));
+  THREAD_POOL = thread_pool_;
 
   // MARKER add reporter here
   VLOG(1) << "Initialing reporter(s)...";
@@ -217,6 +222,7 @@ void Model::initialize(int job_number, const std::string &path) {
     // Get the validator and prepare it for the run
     auto &validator = MovementValidation::get_instance();
     validator.set_reporter((MovementReporter*)reporter);
+    validator.set_sampling_rate(movement_sampling_rate_);
 
     // Set the flags on the validator
     if (individual_movement_) {
@@ -267,7 +273,6 @@ void Model::initialize_object_pool(const int &size) {
   ClonalParasitePopulation::InitializeObjectPool(size);
   SingleHostClonalParasitePopulations::InitializeObjectPool();
 
-  Drug::InitializeObjectPool(size);
   DrugsInBlood::InitializeObjectPool(size);
 
   //    InfantImmuneComponent::InitializeObjectPool(size);
@@ -288,7 +293,6 @@ void Model::release_object_pool() {
   //    NonInfantImmuneComponent::ReleaseObjectPool();
 
   DrugsInBlood::ReleaseObjectPool();
-  Drug::ReleaseObjectPool();
 
   SingleHostClonalParasitePopulations::ReleaseObjectPool();
   ClonalParasitePopulation::ReleaseObjectPool();
@@ -350,7 +354,11 @@ void Model::begin_time_step() {
 
 void Model::perform_population_events_daily() const {
   // TODO: turn on and off time for art mutation in the input file
-  population_->perform_infection_event();
+  // Without parasites there are no bites to inflict
+  if (!scheduler_->fast_forward()) {
+    population_->update_effective_beta();
+    population_->perform_infection_event();
+  }
   population_->perform_birth_event();
   population_->perform_circulation_event();
 }
@@ -384,14 +392,6 @@ void Model::yearly_update() { data_collector_->yearly_update(); }
 
 void Model::release() {
   // Clean up the memory used by the model
-  ObjectHelpers::delete_pointer<ClinicalUpdateFunction>(
-      progress_to_clinical_update_function_);
-  ObjectHelpers::delete_pointer<ImmunityClearanceUpdateFunction>(
-      immunity_clearance_update_function_);
-  ObjectHelpers::delete_pointer<ImmunityClearanceUpdateFunction>(
-      having_drug_update_function_);
-  ObjectHelpers::delete_pointer<ImmunityClearanceUpdateFunction>(
-      clinical_update_function_);
   ObjectHelpers::delete_pointer<Population>(population_);
   ObjectHelpers::delete_pointer<Scheduler>(scheduler_);
   ObjectHelpers::delete_pointer<MainDataCollector>(data_collector_);
@@ -401,6 +401,7 @@ void Model::release() {
 
   ObjectHelpers::delete_pointer<Config>(config_);
   ObjectHelpers::delete_pointer<Random>(random_);
+  ObjectHelpers::delete_pointer<ThreadPool>(thread_pool_);
 
   for (Reporter* reporter : reporters_) {
     ObjectHelpers::delete_pointer<Reporter>(reporter);
@@ -413,6 +414,7 @@ void Model::release() {
   RANDOM = nullptr;
   MAIN_DATA_COLLECTOR = nullptr;
   POPULATION = nullptr;
+  THREAD_POOL = nullptr;
   TREATMENT_STRATEGY = nullptr;
   TREATMENT_COVERAGE = nullptr;
 }
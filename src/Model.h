@@ -10,14 +10,13 @@
 
 #include "Core/PropertyMacro.h"
 #include "Core/Scheduler.h"
-#include "Population/ParasiteDensity/ClinicalUpdateFunction.h"
-#include "Population/ParasiteDensity/ImmunityClearanceUpdateFunction.h"
 #include "Treatment/ITreatmentCoverageModel.h"
 
 class Scheduler;
 class Population;
 class Config;
 class Random;
+class ThreadPool;
 class MainDataCollector;
 class Reporter;
 class MovementReporter;
@@ -30,11 +29,7 @@ class Model {
   POINTER_PROPERTY(Population, population)
   POINTER_PROPERTY(Random, random)
   POINTER_PROPERTY(MainDataCollector, data_collector)
-  POINTER_PROPERTY(ClinicalUpdateFunction, progress_to_clinical_update_function)
-  POINTER_PROPERTY(ImmunityClearanceUpdateFunction,
-                   immunity_clearance_update_function)
-  POINTER_PROPERTY(ImmunityClearanceUpdateFunction, having_drug_update_function)
-  POINTER_PROPERTY(ImmunityClearanceUpdateFunction, clinical_update_function)
+  POINTER_PROPERTY(ThreadPool, thread_pool)
 
   PROPERTY_REF(std::vector<Reporter*>, reporters)
   PROPERTY_REF(std::string, config_filename)
@@ -48,6 +43,7 @@ class Model {
   PROPERTY_REF(bool, individual_movement)
   PROPERTY_REF(bool, cell_movement)
   PROPERTY_REF(bool, district_movement)
+  PROPERTY_REF(double, movement_sampling_rate)
   PROPERTY_REF(bool, is_farm_output)
   PROPERTY_REF(std::string, reporter_type)
   PROPERTY_REF(int, replicate)
@@ -59,6 +55,7 @@ public:
   static Scheduler* SCHEDULER;
   static MainDataCollector* MAIN_DATA_COLLECTOR;
   static Population* POPULATION;
+  static ThreadPool* THREAD_POOL;
   static IStrategy* TREATMENT_STRATEGY;
   static ITreatmentCoverageModel* TREATMENT_COVERAGE;
 
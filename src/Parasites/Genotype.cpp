@@ -7,6 +7,8 @@
 
 #include "Genotype.h"
 
+#include <cmath>
+
 #include "Core/Config/Config.h"
 #include "Core/Random.h"
 #include "Model.h"
@@ -31,6 +33,8 @@ Genotype::Genotype(const int &id, const GenotypeInfo &genotype_info,
                                                .alleles[gene_expression_[i]]
                                                .daily_cost_of_resistance;
   }
+  log10_daily_fitness_multiple_infection_ =
+      log10(daily_fitness_multiple_infection_);
 
   // number_of_resistance_position (level)
   number_of_resistance_position_ = 0;
@@ -67,16 +71,8 @@ bool Genotype::resist_to(Therapy* therapy) {
 
 Genotype* Genotype::combine_mutation_to(const int &locus, const int &value) {
   if (gene_expression_[locus] == value) { return this; }
-
-  int id = 0;
-  for (std::size_t i = 0; i < gene_expression_.size(); i++) {
-    if (i == static_cast<std::size_t>(locus)) {
-      id += Model::CONFIG->genotype_db()->weight()[i] * value;
-    } else {
-      id += Model::CONFIG->genotype_db()->weight()[i] * gene_expression_[i];
-    }
-  }
-  return Model::CONFIG->genotype_db()->at(id);
+  return Model::CONFIG->genotype_db()->get_mutation_neighbor(genotype_id_,
+                                                              locus, value);
 }
 
 double Genotype::get_EC50_power_n(DrugType* dt) const {
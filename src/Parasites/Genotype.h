@@ -20,7 +20,10 @@ class DrugType;
 class Therapy;
 
 class Genotype {
-  DELETE_COPY_AND_MOVE(Genotype)
+  // Genotypes are only moved while the GenotypeDatabase is being built
+  Genotype(Genotype const &) = delete;
+  void operator=(Genotype const &) = delete;
+  Genotype &operator=(Genotype &&) = delete;
 
   PROPERTY_REF(int, genotype_id)
 
@@ -28,6 +31,9 @@ class Genotype {
 
   PROPERTY_REF(double, daily_fitness_multiple_infection)
 
+  // Cached log10 of the daily fitness, used when updating parasite densities
+  PROPERTY_REF(double, log10_daily_fitness_multiple_infection)
+
   PROPERTY_REF(int, number_of_resistance_position)
 
   POINTER_PROPERTY(DrugDatabase, drug_db)
@@ -36,6 +42,8 @@ public:
   explicit Genotype(const int &id, const GenotypeInfo &genotype_info,
                     const IntVector &weight);
 
+  Genotype(Genotype &&) = default;
+
   virtual ~Genotype();
 
   double get_EC50_power_n(DrugType* dt) const;
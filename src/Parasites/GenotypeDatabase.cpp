@@ -6,76 +6,107 @@
  */
 #include "GenotypeDatabase.h"
 
+#include <algorithm>
+
 #include "Core/Config/Config.h"
 #include "Genotype.h"
-#include "Helpers/NumberHelpers.hxx"
 
-GenotypeDatabase::~GenotypeDatabase() {
-  for (auto &i : *this) { delete i.second; }
-  clear();
-  delete mating_matrix;
-}
+GenotypeDatabase::~GenotypeDatabase() = default;
 
-void GenotypeDatabase::add(Genotype* genotype) {
-  if (this->find(genotype->genotype_id()) != this->end()) {
-    delete (*this)[genotype->genotype_id()];
+void GenotypeDatabase::build(const GenotypeInfo &genotype_info) {
+  auto number_of_genotypes = 1;
+  for (auto &locus : genotype_info.loci_vector) {
+    number_of_genotypes *= static_cast<int>(locus.alleles.size());
   }
-  (*this)[genotype->genotype_id()] = genotype;
+
+  genotypes_.clear();
+  genotypes_.reserve(number_of_genotypes);
+  for (auto id = 0; id < number_of_genotypes; id++) {
+    genotypes_.emplace_back(id, genotype_info, weight_);
+  }
+
+  // Any cached matings are keyed on the size of the database
+  mating_cache_.clear();
+
+  build_mutation_neighbors(genotype_info);
 }
 
-void GenotypeDatabase::initialize_matting_matrix() {
-  const int size = static_cast<const int>(this->size());
-  auto working = MatingMatrix(
-      size, std::vector<std::vector<double>>(size, std::vector<double>()));
+void GenotypeDatabase::build_mutation_neighbors(
+    const GenotypeInfo &genotype_info) {
+  // Each genotype has one entry per allele of every locus
+  locus_offset_.clear();
+  neighbor_stride_ = 0;
+  for (auto &locus : genotype_info.loci_vector) {
+    locus_offset_.push_back(static_cast<int>(neighbor_stride_));
+    neighbor_stride_ += locus.alleles.size();
+  }
 
-  for (auto m = 0; m < size; m++) {
-    for (auto f = 0; f < m; f++) {
-      working[m][f] = generate_offspring_parasite_density(
-          (*this)[m]->gene_expression(), (*this)[f]->gene_expression());
+  mutation_neighbors_.assign(genotypes_.size() * neighbor_stride_, nullptr);
+  for (auto &genotype : genotypes_) {
+    const auto &gene = genotype.gene_expression();
+    const auto base = genotype.genotype_id() * neighbor_stride_;
+    for (std::size_t locus = 0; locus < gene.size(); locus++) {
+      // Remove the current allele from the id, the neighbor for each allele is
+      // then a single step along the locus weight
+      const auto id = genotype.genotype_id() - weight_[locus] * gene[locus];
+      const auto alleles = genotype_info.loci_vector[locus].alleles.size();
+      for (std::size_t allele = 0; allele < alleles; allele++) {
+        mutation_neighbors_[base + locus_offset_[locus] + allele] =
+            &genotypes_[id + weight_[locus] * allele];
+      }
     }
   }
-
-  mating_matrix = Flat3D<double>::flatten(working);
 }
 
-std::vector<double> GenotypeDatabase::generate_offspring_parasite_density(
+OffspringDistribution GenotypeDatabase::generate_offspring_distribution(
     const IntVector &m, const IntVector &f) {
-  std::vector<IntVector> results;
-  // add first one
-  const IntVector ge(m.size(), 0);
-  results.push_back(ge);
-
+  // Enumerate the recombinant genotype ids directly, loci where the parents
+  // carry the same allele do not branch so each recombinant is only produced
+  // once and has the same density.
+  std::vector<int> ids{0};
   for (std::size_t i = 0; i < m.size(); i++) {
-    const int old_size = static_cast<const int>(results.size());
-    for (auto j = 0; j < old_size; j++) {
-      results.push_back(results[j]);
-      results[j][i] = m[i];
-      results[results.size() - 1][i] = f[i];
+    if (m[i] == f[i]) {
+      for (auto &id : ids) { id += weight_[i] * m[i]; }
+      continue;
     }
-  }
-
-  std::vector<double> recombination_parasite_density(this->size(), 0.0);
-
-  for (auto &ge_i : results) {
-    recombination_parasite_density[get_id(ge_i)] += 1;
-  }
-
-  for (auto &density : recombination_parasite_density) {
-    if (NumberHelpers::is_not_zero(density)) {
-      density /= static_cast<double>(results.size());
+    const auto old_size = ids.size();
+    for (std::size_t j = 0; j < old_size; j++) {
+      ids.push_back(ids[j] + weight_[i] * f[i]);
+      ids[j] += weight_[i] * m[i];
     }
   }
+  std::sort(ids.begin(), ids.end());
+
+  OffspringDistribution result;
+  result.reserve(ids.size());
+  const auto density = 1.0 / static_cast<double>(ids.size());
+  for (auto id : ids) { result.push_back({id, density}); }
+  return result;
+}
 
-  return recombination_parasite_density;
+const OffspringDistribution &GenotypeDatabase::get_offspring_distribution(
+    const int &m, const int &f) {
+  const auto key = mating_key(m, f);
+  auto it = mating_cache_.find(key);
+  if (it != mating_cache_.end()) { return it->second; }
+
+  return mating_cache_
+      .emplace(key, generate_offspring_distribution(
+                        (*this)[m]->gene_expression(),
+                        (*this)[f]->gene_expression()))
+      .first->second;
 }
 
-// Get the offspring density from the flat matrix.
+// Get the offspring density from the sparse mating store.
 double GenotypeDatabase::get_offspring_density(const int &m, const int &f,
                                                const int &p) {
   if (m == f) { return (f == p) ? 1 : 0; }
 
-  if (m < f) { return mating_matrix->get(f, m, p); }
-  return mating_matrix->get(m, f, p);
+  for (const auto &offspring : get_offspring_distribution(m, f)) {
+    if (offspring.genotype_id == p) { return offspring.density; }
+    if (offspring.genotype_id > p) { break; }
+  }
+  return 0;
 }
 
 int GenotypeDatabase::get_id(const IntVector &gene) {
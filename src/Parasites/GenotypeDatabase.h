@@ -8,9 +8,10 @@
 #ifndef PARASITEDATABASE_H
 #define PARASITEDATABASE_H
 
-#include <map>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
-#include "Core/FlatArray.hxx"
 #include "Core/PropertyMacro.h"
 #include "Core/TypeDef.h"
 #include "Genotype.h"
@@ -18,39 +19,84 @@
 
 class Genotype;
 
-typedef std::map<ul, Genotype*> GenotypePtrMap;
-typedef std::vector<std::vector<std::vector<double>>> MatingMatrix;
+// The density of a single offspring genotype produced by a mating.
+struct OffspringDensity {
+  int genotype_id;
+  double density;
+};
+
+// The non-zero offspring densities of a mating, sorted by genotype id.
+typedef std::vector<OffspringDensity> OffspringDistribution;
 
-class GenotypeDatabase : public GenotypePtrMap {
+class GenotypeDatabase {
   DELETE_COPY_AND_MOVE(GenotypeDatabase)
 
   VIRTUAL_PROPERTY_REF(IntVector, weight)
 
 private:
-  Flat3D<double>* mating_matrix = nullptr;
+  // Genotypes stored contiguously and indexed by their genotype id, the
+  // storage is only sized once by build so pointers to them remain valid.
+  std::vector<Genotype> genotypes_;
+
+  // Flattened [genotype][locus][allele] table of the genotype produced by
+  // mutating the given locus to the given allele.
+  std::vector<Genotype*> mutation_neighbors_;
+  IntVector locus_offset_;
+  std::size_t neighbor_stride_ = 0;
+
+  void build_mutation_neighbors(const GenotypeInfo &genotype_info);
+
+  // Sparse mating store, the offspring distribution for a pair of parents is
+  // only generated the first time the pair mates and is then cached. Keys are
+  // produced by mating_key with the larger genotype id first.
+  std::unordered_map<std::uint64_t, OffspringDistribution> mating_cache_;
 
-  // This is generally bad practice, but since the method gets called a lot
-  // during the model we need to get as much performance as we can out of it.
-  // By making the function a friend we can avoid any stack calls at the
-  // expense of needing to be more diligent about our code.
-  friend void SingleHostClonalParasitePopulations::
-      update_relative_effective_parasite_density_using_free_recombination();
+  [[nodiscard]] std::uint64_t mating_key(const int &m, const int &f) const {
+    return (m > f) ? static_cast<std::uint64_t>(m) * size() + f
+                   : static_cast<std::uint64_t>(f) * size() + m;
+  }
 
 public:
   GenotypeDatabase() = default;
 
   virtual ~GenotypeDatabase();
 
-  void add(Genotype* genotype);
+  // Create every genotype described by the genotype information along with the
+  // mutation neighbor table, the weights must already be set.
+  void build(const GenotypeInfo &genotype_info);
+
+  [[nodiscard]] std::size_t size() const { return genotypes_.size(); }
+
+  Genotype* at(const std::size_t &id) { return &genotypes_.at(id); }
+
+  Genotype* operator[](const std::size_t &id) { return &genotypes_[id]; }
+
+  // Get the genotype that results from mutating the locus of the genotype to
+  // the allele given.
+  Genotype* get_mutation_neighbor(const int &genotype_id, const int &locus,
+                                  const int &allele) const {
+    return mutation_neighbors_[genotype_id * neighbor_stride_
+                               + locus_offset_[locus] + allele];
+  }
 
   int get_id(const IntVector &gene);
 
-  void initialize_matting_matrix();
+  // Generate the offspring distribution for the given parental gene
+  // expressions under free recombination.
+  OffspringDistribution generate_offspring_distribution(const IntVector &m,
+                                                        const IntVector &f);
 
-  std::vector<double> generate_offspring_parasite_density(const IntVector &m,
-                                                          const IntVector &f);
+  // Get the offspring distribution for the parents, generating and caching it
+  // on the first call for the pair. Parents must be different genotypes.
+  const OffspringDistribution &get_offspring_distribution(const int &m,
+                                                          const int &f);
 
   double get_offspring_density(const int &m, const int &f, const int &p);
+
+  // Return the number of parent pairs that have been cached.
+  [[nodiscard]] std::size_t mating_cache_size() const {
+    return mating_cache_.size();
+  }
 };
 
 #endif
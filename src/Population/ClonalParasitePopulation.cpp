@@ -9,7 +9,9 @@
 
 #include "Core/Config/Config.h"
 #include "Helpers/NumberHelpers.hxx"
+#include "ImmuneSystem.h"
 #include "Model.h"
+#include "Parasites/Genotype.h"
 #include "Person.h"
 #include "SingleHostClonalParasitePopulations.h"
 #include "Therapies/Therapy.hxx"
@@ -22,7 +24,7 @@ ClonalParasitePopulation::ClonalParasitePopulation(Genotype* genotype)
       first_date_in_blood_(-1),
       parasite_population_(nullptr),
       genotype_(genotype),
-      update_function_(nullptr) {
+      update_function_(ParasiteDensityUpdateFunction::NONE) {
   _uid = UniqueId::get_instance().get_uid();
 }
 
@@ -34,11 +36,19 @@ double ClonalParasitePopulation::get_current_parasite_density(
       current_time - parasite_population()->latest_update_time();
   if (duration == 0) { return last_update_log10_parasite_density_; }
 
-  if (update_function_ == nullptr) {
-    return last_update_log10_parasite_density_;
+  switch (update_function_) {
+    case ParasiteDensityUpdateFunction::NONE:
+      return last_update_log10_parasite_density_;
+    case ParasiteDensityUpdateFunction::PROGRESS_TO_CLINICAL:
+      return Model::CONFIG->parasite_density_level()
+          .log_parasite_density_asymptomatic;
+    default:
+      return parasite_population_->person()
+          ->immune_system()
+          ->get_parasite_size_after_t_days(
+              duration, last_update_log10_parasite_density_,
+              genotype_->daily_fitness_multiple_infection());
   }
-
-  return update_function_->get_current_parasite_density(this, duration);
 }
 
 double ClonalParasitePopulation::get_log10_relative_density() const {
@@ -89,11 +99,6 @@ bool ClonalParasitePopulation::resist_to(const int &drug_id) const {
   return genotype_->resist_to(Model::CONFIG->drug_db()->at(drug_id));
 }
 
-void ClonalParasitePopulation::update() {
-  set_last_update_log10_parasite_density(
-      get_current_parasite_density(Model::SCHEDULER->current_time()));
-}
-
 void ClonalParasitePopulation::perform_drug_action(
     const double &percent_parasite_remove) {
   double newSize = last_update_log10_parasite_density_;
@@ -33,11 +33,14 @@ class ClonalParasitePopulation : public IndexHandler {
 
   POINTER_PROPERTY_HEADER(Genotype, genotype)
 
-  POINTER_PROPERTY(ParasiteDensityUpdateFunction, update_function)
+  PROPERTY(ParasiteDensityUpdateFunction, update_function)
 
 private:
   ul_uid _uid;
 
+  // The densities of the clones are updated as a batch by the host
+  friend class SingleHostClonalParasitePopulations;
+
 public:
   static constexpr double LOG_ZERO_PARASITE_DENSITY = -1000;
 
@@ -52,8 +55,6 @@ public:
 
   [[nodiscard]] bool resist_to(const int &drug_id) const;
 
-  void update();
-
   void perform_drug_action(const double &percent_parasite_remove);
 
   [[nodiscard]] ul_uid get_uid() const { return _uid; }
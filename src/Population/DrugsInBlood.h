@@ -2,15 +2,27 @@
  * DrugsInBlood.h
  *
  * Define the class that tracks the drugs that are currently in the blood.
+ *
+ * The drugs are stored inline in a fixed number of slots that are indexed by
+ * the drug type id, with a bitmask indicating which of the slots are currently
+ * active. This avoids a heap allocation per drug (and per map node) when a
+ * treatment is given, and allows the daily update to walk the active drugs
+ * without chasing pointers.
  */
 #ifndef DRUGSINBLOOD_H
 #define DRUGSINBLOOD_H
 
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #include "Core/ObjectPool.h"
 #include "Core/PropertyMacro.h"
 #include "Core/TypeDef.h"
+#include "Therapies/Drug.h"
 
-class Drug;
 class DrugType;
 class Person;
 
@@ -21,36 +33,70 @@ class DrugsInBlood {
 
   POINTER_PROPERTY(Person, person)
 
-  POINTER_PROPERTY(DrugPtrMap, drugs)
-
 public:
+  // Maximum number of drug types that can be configured, this is also the
+  // number of drug slots held by each individual
+  static constexpr int MAX_DRUG_TYPES = 16;
+
   // Cutoff drugs that are less than or equal to 10%
-  const double DRUG_CUTOFF_VALUE = 0.1;
+  static constexpr double DRUG_CUTOFF_VALUE = 0.1;
+
+private:
+  // Drug slots indexed by the drug type id, only the slots flagged in active_
+  // hold a drug that is in the blood
+  Drug drugs_[MAX_DRUG_TYPES];
+
+  std::uint32_t active_{0};
+
+  // Return the index of the lowest set bit, the mask must not be zero
+  static int lowest_set_bit(std::uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+  }
 
+public:
   explicit DrugsInBlood(Person* person = nullptr);
 
   virtual ~DrugsInBlood();
 
-  void init();
-
-  Drug* add_drug(Drug* drug);
+  // Add the drug type to the blood and return the slot for it. If the drug is
+  // already present in the blood (ex., as part of a MACTherapy) the existing
+  // slot is returned as-is so the caller can read the prior values before
+  // setting the new course of treatment.
+  Drug* add_drug(DrugType* drug_type);
 
-  bool is_drug_in_blood(DrugType* drug_type) const;
+  [[nodiscard]] bool is_drug_in_blood(DrugType* drug_type) const;
 
-  [[nodiscard]] bool is_drug_in_blood(int drug_type_id) const;
+  [[nodiscard]] bool is_drug_in_blood(int drug_type_id) const {
+    return (active_ & (1U << drug_type_id)) != 0;
+  }
 
-  [[nodiscard]] Drug* get_drug(const int &type_id) const;
+  [[nodiscard]] Drug* get_drug(const int &type_id);
 
   [[nodiscard]] std::size_t size() const;
 
-  void clear() const;
+  void clear();
 
-  void update() const;
+  void update();
 
   // Clear the drugs that were cut off.
   // This function was originally named clear_cut_off_drugs_by_event and took
   // the calling Event object as a parameter.
-  void clear_cut_off_drugs() const;
+  void clear_cut_off_drugs();
+
+  // Invoke the function for each drug that is currently in the blood, in
+  // order of the drug type id.
+  template <typename Function>
+  void for_each_drug(Function function) {
+    for (auto mask = active_; mask != 0; mask &= mask - 1) {
+      function(drugs_[lowest_set_bit(mask)]);
+    }
+  }
 };
 
 #endif
@@ -20,19 +20,21 @@ ImmuneComponent::ImmuneComponent(ImmuneSystem* immune_system)
 ImmuneComponent::~ImmuneComponent() { immune_system_ = nullptr; }
 
 double ImmuneComponent::get_current_value() {
+  return get_value_at(Model::SCHEDULER->current_time());
+}
+
+double ImmuneComponent::get_value_at(const int &time) {
   auto temp = 0.0;
   if (immune_system_ != nullptr && immune_system_->person() != nullptr) {
-    const auto currentTime = Model::SCHEDULER->current_time();
-    const auto duration =
-        currentTime - immune_system_->person()->latest_update_time();
+    const auto duration = time - immune_system_->person()->latest_update_time();
 
     const auto age = immune_system_->person()->age();
     if (immune_system_->increase()) {
       // Increase according to: I(t) = 1 - (1-I0)e^(-b1*t)
-      temp = 1 - (1 - latest_value_) * exp(-get_acquire_rate(age) * duration);
+      temp = 1 - (1 - latest_value_) * get_acquire_factor(age, duration);
     } else {
       // Decrease according to: I(t) = I0 * e ^ (-b2*t)
-      temp = latest_value_ * exp(-get_decay_rate(age) * duration);
+      temp = latest_value_ * get_decay_factor(age, duration);
 
       // If we are effectively zero, then set that value
       temp = (temp < 0.00001) ? 0.0 : temp;
@@ -41,9 +43,19 @@ double ImmuneComponent::get_current_value() {
   return temp;
 }
 
+double ImmuneComponent::get_acquire_factor(const int &age,
+                                           const int &duration) const {
+  return exp(-get_acquire_rate(age) * duration);
+}
+
+double ImmuneComponent::get_decay_factor(const int &age,
+                                         const int &duration) const {
+  return exp(-get_decay_rate(age) * duration);
+}
+
 void ImmuneComponent::update() { latest_value_ = get_current_value(); }
 
 void ImmuneComponent::draw_random_immune() {
-  const auto ims = Model::CONFIG->immune_system_information();
+  const auto &ims = Model::CONFIG->immune_system_information();
   latest_value_ = Model::RANDOM->random_beta(ims.alpha_immune, ims.beta_immune);
 }
@@ -27,11 +27,23 @@ public:
 
   virtual void draw_random_immune();
 
-  virtual double get_current_value();
+  double get_current_value();
+
+  // Return the value the immune component will have at the given time,
+  // assuming no update is made between the latest update and that time
+  virtual double get_value_at(const int &time);
 
   [[nodiscard]] virtual double get_decay_rate(const int &age) const = 0;
 
   [[nodiscard]] virtual double get_acquire_rate(const int &age) const = 0;
+
+  // Return the exp(-rate * duration) term for the acquisition or decay of
+  // immunity, derived classes may override these to use a lookup table
+  [[nodiscard]] virtual double get_acquire_factor(const int &age,
+                                                  const int &duration) const;
+
+  [[nodiscard]] virtual double get_decay_factor(const int &age,
+                                                const int &duration) const;
 };
 
 #endif
@@ -7,6 +7,7 @@
 
 #include <cmath>
 
+#include "Helpers/LookupTables.hxx"
 #include "Model.h"
 #include "Population/ImmuneSystem.h"
 #include "Population/Person.h"
@@ -22,14 +23,14 @@ double InfantImmuneComponent::get_decay_rate(const int &age) const {
   return 0.0315;
 }
 
-double InfantImmuneComponent::get_current_value() {
+double InfantImmuneComponent::get_value_at(const int &time) {
   auto temp = 0.0;
   if (immune_system() != nullptr && immune_system()->person() != nullptr) {
-    const auto current_time = Model::SCHEDULER->current_time();
     const auto duration =
-        current_time - immune_system()->person()->latest_update_time();
+        time - immune_system()->person()->latest_update_time();
     // Decrease immune response by: I(t) = I0 * e ^ (-b2*t);
-    temp = latest_value() * exp(-get_decay_rate(0) * duration);
+    static const ExponentialDecayTable decay(get_decay_rate(0));
+    temp = latest_value() * decay(duration);
   }
   return temp;
 }
@@ -20,7 +20,7 @@ public:
 
   [[nodiscard]] double get_acquire_rate(const int &age) const override;
 
-  double get_current_value() override;
+  double get_value_at(const int &time) override;
 };
 
 #endif
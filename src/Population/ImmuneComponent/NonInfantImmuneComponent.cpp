@@ -21,3 +21,15 @@ double NonInfantImmuneComponent::get_acquire_rate(const int &age) const {
 double NonInfantImmuneComponent::get_decay_rate(const int &age) const {
   return Model::CONFIG->immune_system_information().decay_rate;
 }
+
+double NonInfantImmuneComponent::get_acquire_factor(const int &age,
+                                                    const int &duration) const {
+  const auto &tables =
+      Model::CONFIG->immune_system_information().acquire_by_age;
+  return (age > 80) ? tables[80](duration) : tables[age](duration);
+}
+
+double NonInfantImmuneComponent::get_decay_factor(const int &age,
+                                                  const int &duration) const {
+  return Model::CONFIG->immune_system_information().decay(duration);
+}
@@ -20,6 +20,12 @@ public:
   [[nodiscard]] double get_decay_rate(const int &age) const override;
 
   [[nodiscard]] double get_acquire_rate(const int &age) const override;
+
+  [[nodiscard]] double get_acquire_factor(const int &age,
+                                          const int &duration) const override;
+
+  [[nodiscard]] double get_decay_factor(const int &age,
+                                        const int &duration) const override;
 };
 
 #endif
@@ -8,6 +8,7 @@
 #include <cmath>
 
 #include "Core/Config/Config.h"
+#include "Core/Scheduler.h"
 #include "Helpers/ObjectHelpers.h"
 #include "Model.h"
 #include "Person.h"
@@ -38,6 +39,7 @@ void ImmuneSystem::set_immune_component(ImmuneComponent* value) {
 
     immune_component_ = value;
     immune_component_->set_immune_system(this);
+    cached_time_ = -1;
   }
 }
 
@@ -50,32 +52,50 @@ void ImmuneSystem::set_latest_immune_value(double value) {
 }
 
 double ImmuneSystem::get_current_value() const {
-  return immune_component_->get_current_value();
+  if (person_ == nullptr) { return immune_component_->get_current_value(); }
+
+  const auto current_time = Model::SCHEDULER->current_time();
+  const auto update_time = person_->latest_update_time();
+  const auto age = person_->age();
+  const auto latest_value = immune_component_->latest_value();
+  if (cached_time_ != current_time || cached_update_time_ != update_time
+      || cached_age_ != age || cached_increase_ != increase_
+      || cached_latest_value_ != latest_value) {
+    cached_value_ = immune_component_->get_current_value();
+    cached_time_ = current_time;
+    cached_update_time_ = update_time;
+    cached_age_ = age;
+    cached_increase_ = increase_;
+    cached_latest_value_ = latest_value;
+  }
+  return cached_value_;
 }
 
-double ImmuneSystem::get_parasite_size_after_t_days(
-    const int &duration, const double &originalSize,
-    const double &fitness) const {
+double ImmuneSystem::get_value_at(const int &time) const {
+  return immune_component_->get_value_at(time);
+}
+
+double ImmuneSystem::get_log10_clearance_rate() const {
   const auto last_immune_level = get_latest_immune_value();
   const auto temp =
       Model::CONFIG->immune_system_information().c_max * (1 - last_immune_level)
       + Model::CONFIG->immune_system_information().c_min * last_immune_level;
+  return log10(temp);
+}
 
-  const auto value = originalSize + duration * (log10(temp) + log10(fitness));
+double ImmuneSystem::get_parasite_size_after_t_days(
+    const int &duration, const double &originalSize,
+    const double &fitness) const {
+  const auto value =
+      originalSize + duration * (get_log10_clearance_rate() + log10(fitness));
   return value;
 }
 
 double ImmuneSystem::get_clinical_progression_probability() const {
-  const auto immune = get_current_value();
-  const auto isf = Model::CONFIG->immune_system_information();
-
-  const auto pr_clinical =
-      isf.max_clinical_probability
-      / (1
-         + pow((immune / isf.midpoint),
-               isf.immune_effect_on_progression_to_clinical));
-
-  return pr_clinical;
+  // The sigmoidal curve, max / (1 + (immune / midpoint)^slope), is precomputed
+  // over the immune level when the configuration is loaded
+  const auto &isf = Model::CONFIG->immune_system_information();
+  return isf.clinical_progression(get_current_value());
 }
 
 void ImmuneSystem::update() { immune_component_->update(); }
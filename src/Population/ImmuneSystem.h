@@ -26,6 +26,17 @@ class ImmuneSystem {
 
   POINTER_PROPERTY_HEADER(ImmuneComponent, immune_component)
 
+private:
+  // The current immune value is memoized since it is queried for each bite as
+  // well as when determining clinical progression. The value is keyed on the
+  // inputs it depends upon so that any change invalidates it.
+  mutable int cached_time_{-1};
+  mutable int cached_update_time_{-1};
+  mutable int cached_age_{-1};
+  mutable bool cached_increase_{false};
+  mutable double cached_latest_value_{0.0};
+  mutable double cached_value_{0.0};
+
 public:
   explicit ImmuneSystem(Person* person = nullptr);
 
@@ -39,6 +50,14 @@ public:
 
   [[nodiscard]] virtual double get_current_value() const;
 
+  // Return the immune value at the given time, which should not be before the
+  // latest update of the individual
+  [[nodiscard]] virtual double get_value_at(const int &time) const;
+
+  // Return the daily change in the log10 parasite density due to the immune
+  // response, this is the same for all clones in the host
+  [[nodiscard]] virtual double get_log10_clearance_rate() const;
+
   [[nodiscard]] virtual double get_parasite_size_after_t_days(
       const int &duration, const double &originalSize,
       const double &fitness) const;
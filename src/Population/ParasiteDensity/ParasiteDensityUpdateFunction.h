@@ -1,25 +1,32 @@
 /*
  * ParasiteUpdateFunction.h
  *
- * Define the parasite update function interface.
+ * Define the functions that govern how the density of a clonal parasite
+ * population is updated. The function is stored on each clone and the densities
+ * for all of the clones in a host are updated together by
+ * SingleHostClonalParasitePopulations::update.
+ *
+ * NOTE that the immune clearance is the same for IMMUNITY_CLEARANCE,
+ *      HAVING_DRUG, and CLINICAL; however, they are tracked separately since
+ *      events use them to determine the state of the clone.
  */
 #ifndef PARASITEDENSITYUPDATEFUNCTION_H
 #define PARASITEDENSITYUPDATEFUNCTION_H
 
-#include "Core/PropertyMacro.h"
-
-class ClonalParasitePopulation;
-
-class ParasiteDensityUpdateFunction {
-  DELETE_COPY_AND_MOVE(ParasiteDensityUpdateFunction)
+#include <cstdint>
 
-public:
-  ParasiteDensityUpdateFunction() = default;
+enum class ParasiteDensityUpdateFunction : std::uint8_t {
+  // The density is not updated
+  NONE,
 
-  virtual ~ParasiteDensityUpdateFunction() = default;
+  // The clone is progressing to clinical, the density is held at the
+  // asymptomatic level
+  PROGRESS_TO_CLINICAL,
 
-  virtual double get_current_parasite_density(
-      ClonalParasitePopulation* parasite, int duration) = 0;
+  // The density is updated based upon the immune response and fitness
+  IMMUNITY_CLEARANCE,
+  HAVING_DRUG,
+  CLINICAL
 };
 
 #endif
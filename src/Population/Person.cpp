@@ -82,7 +82,6 @@ void Person::init() {
   all_clonal_parasite_populations_->init();
 
   drugs_in_blood_ = new DrugsInBlood(this);
-  drugs_in_blood_->init();
 
   today_infections_ = new IntVector();
   today_target_locations_ = new IntVector();
@@ -217,9 +216,7 @@ void Person::increase_age_by_1_year() { set_age(age_ + 1); }
 
 ClonalParasitePopulation* Person::add_new_parasite_to_blood(
     Genotype* parasite_type) const {
-  auto* blood_parasite = new ClonalParasitePopulation(parasite_type);
-
-  all_clonal_parasite_populations_->add(blood_parasite);
+  auto* blood_parasite = all_clonal_parasite_populations_->add(parasite_type);
 
   blood_parasite->set_last_update_log10_parasite_density(
       Model::CONFIG->parasite_density_level().log_parasite_density_from_liver);
@@ -250,12 +247,9 @@ double Person::get_biting_level_value() {
 }
 
 double Person::relative_infectivity(const double &log10_parasite_density) {
-  const auto d_n =
-      log10_parasite_density * Model::CONFIG->relative_infectivity().sigma
-      + Model::CONFIG->relative_infectivity().ro_star;
-  const auto p = Model::RANDOM->cdf_standard_normal_distribution(d_n);
-
-  return p * p + 0.01;
+  // The curve, Phi(D_n)^2 + 0.01, is precomputed when the configuration is
+  // loaded
+  return Model::CONFIG->relative_infectivity()(log10_parasite_density);
 }
 
 double Person::get_probability_progress_to_clinical() {
@@ -278,8 +272,8 @@ void Person::cancel_all_events_except(Event* event) const {
 }
 
 void Person::change_all_parasite_update_function(
-    ParasiteDensityUpdateFunction* from,
-    ParasiteDensityUpdateFunction* to) const {
+    ParasiteDensityUpdateFunction from,
+    ParasiteDensityUpdateFunction to) const {
   all_clonal_parasite_populations_->change_all_parasite_update_function(from,
                                                                         to);
 }
@@ -405,11 +399,6 @@ void Person::receive_therapy(SCTherapy* sc_therapy, bool is_mac_therapy) {
 
 void Person::add_drug_to_blood(DrugType* dt, const int &dosing_days,
                                bool is_mac_therapy) {
-  // Prepare the drug object
-  auto* drug = new Drug(dt);
-  drug->set_dosing_days(dosing_days);
-  drug->set_last_update_time(Model::SCHEDULER->current_time());
-
   // Find the mean and standard deviation for the drug, and use those values to
   // determine the drug level for this individual
   const auto sd = dt->age_group_specific_drug_concentration_sd()[age_class_];
@@ -418,13 +407,17 @@ void Person::add_drug_to_blood(DrugType* dt, const int &dosing_days,
   auto drug_level =
       Model::RANDOM->random_normal_truncated(mean_drug_absorption, sd);
 
+  // Get the drug slot, if the drug is already present then the slot still
+  // holds the values from the prior course of treatment
+  const auto already_in_blood = drugs_in_blood_->is_drug_in_blood(dt);
+  auto* drug = drugs_in_blood_->add_drug(dt);
+
   // If this is going to be part of a complex therapy regime then we need to
   // note this initial drug level
   if (is_mac_therapy) {
-    if (drugs_in_blood()->drugs()->find(dt->id())
-        != drugs_in_blood()->drugs()->end()) {
+    if (already_in_blood) {
       // Long half-life drugs are already present in the blood
-      drug_level = drugs_in_blood()->get_drug(dt->id())->starting_value();
+      drug_level = drug->starting_value();
     } else if (starting_mac_drug_values.find(dt->id())
                != starting_mac_drug_values.end()) {
       // Short half-life drugs that were taken, but cleared the blood already
@@ -434,28 +427,23 @@ void Person::add_drug_to_blood(DrugType* dt, const int &dosing_days,
     starting_mac_drug_values[dt->id()] = drug_level;
   }
 
-  // Set the starting level for this course of treatment
+  // Prepare the drug for this course of treatment, the last update value is
+  // carried over if the drug is already present
+  drug->set_dosing_days(dosing_days);
+  drug->set_last_update_time(Model::SCHEDULER->current_time());
   drug->set_starting_value(drug_level);
-
-  if (drugs_in_blood_->is_drug_in_blood(dt)) {
-    drug->set_last_update_value(
-        drugs_in_blood_->get_drug(dt->id())->last_update_value());
-  } else {
-    drug->set_last_update_value(0.0);
-  }
-
+  if (!already_in_blood) { drug->set_last_update_value(0.0); }
   drug->set_start_time(Model::SCHEDULER->current_time());
   drug->set_end_time(Model::SCHEDULER->current_time()
                      + dt->get_total_duration_of_drug_activity(dosing_days));
-
-  drugs_in_blood_->add_drug(drug);
 }
 
 void Person::schedule_update_by_drug_event(
-    ClonalParasitePopulation* clinical_caused_parasite) {
+    ClonalParasitePopulation* clinical_caused_parasite,
+    const ul_uid &clinical_caused_parasite_uid) {
   UpdateWhenDrugIsPresentEvent::schedule_event(
       Model::SCHEDULER, this, clinical_caused_parasite,
-      Model::SCHEDULER->current_time() + 1);
+      clinical_caused_parasite_uid, Model::SCHEDULER->current_time() + 1);
 }
 
 void Person::schedule_end_clinical_event(
@@ -490,14 +478,16 @@ void Person::change_state_when_no_parasite_in_blood() {
 }
 
 void Person::determine_relapse_or_not(
-    ClonalParasitePopulation* clinical_caused_parasite) {
-  if (all_clonal_parasite_populations_->contain(clinical_caused_parasite)) {
+    ClonalParasitePopulation* clinical_caused_parasite,
+    const ul_uid &clinical_caused_parasite_uid) {
+  if (all_clonal_parasite_populations_->contain(clinical_caused_parasite,
+                                                clinical_caused_parasite_uid)) {
     const auto p = Model::RANDOM->random_flat(0.0, 1.0);
 
     if (p <= Model::CONFIG->p_relapse()) {
       // progress to clinical after several days
       clinical_caused_parasite->set_update_function(
-          Model::MODEL->progress_to_clinical_update_function());
+          ParasiteDensityUpdateFunction::PROGRESS_TO_CLINICAL);
       clinical_caused_parasite->set_last_update_log10_parasite_density(
           Model::CONFIG->parasite_density_level()
               .log_parasite_density_asymptomatic);
@@ -514,20 +504,21 @@ void Person::determine_relapse_or_not(
                 .log_parasite_density_asymptomatic);
       }
       clinical_caused_parasite->set_update_function(
-          Model::MODEL->immunity_clearance_update_function());
+          ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
     }
   }
 }
 
 void Person::determine_clinical_or_not(
     ClonalParasitePopulation* clinical_caused_parasite) {
-  if (all_clonal_parasite_populations_->contain(clinical_caused_parasite)) {
+  if (all_clonal_parasite_populations_->contain(
+          clinical_caused_parasite, clinical_caused_parasite->get_uid())) {
     const auto p = Model::RANDOM->random_flat(0.0, 1.0);
 
     if (p <= get_probability_progress_to_clinical()) {
       // progress to clinical after several days
       clinical_caused_parasite->set_update_function(
-          Model::MODEL->progress_to_clinical_update_function());
+          ParasiteDensityUpdateFunction::PROGRESS_TO_CLINICAL);
       clinical_caused_parasite->set_last_update_log10_parasite_density(
           Model::CONFIG->parasite_density_level()
               .log_parasite_density_asymptomatic);
@@ -538,7 +529,7 @@ void Person::determine_clinical_or_not(
       // progress to clearance
 
       clinical_caused_parasite->set_update_function(
-          Model::MODEL->immunity_clearance_update_function());
+          ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
     }
   }
 }
@@ -688,8 +679,33 @@ void Person::schedule_mature_gametocyte_event(
 }
 
 void Person::schedule_update_every_K_days_event(const int &time) {
-  UpdateEveryKDaysEvent::schedule_event(
-      Model::SCHEDULER, this, Model::SCHEDULER->current_time() + time);
+  // When the population is free of parasites the update only ages the
+  // immune system, which can be caught up later, so it is deferred until
+  // parasites may be introduced. The deferred update keeps its phase so the
+  // individuals are not all updated on the same day when the simulation
+  // resumes
+  auto update_time = Model::SCHEDULER->current_time() + time;
+  const auto resume_time = Model::SCHEDULER->resume_time();
+  if (Model::SCHEDULER->fast_forward() && update_time < resume_time) {
+    const auto frequency = Model::CONFIG->update_frequency();
+    const auto periods =
+        (resume_time - update_time + frequency - 1) / frequency;
+    update_time += periods * frequency;
+  }
+  UpdateEveryKDaysEvent::schedule_event(Model::SCHEDULER, this, update_time);
+}
+
+int Person::last_periodic_update_time() const {
+  // The pending update keeps the phase of the updates, so step back from it
+  const auto now = Model::SCHEDULER->current_time();
+  const auto frequency = Model::CONFIG->update_frequency();
+  for (Event* e : *events()) {
+    if (dynamic_cast<UpdateEveryKDaysEvent*>(e) != nullptr && e->executable) {
+      const auto periods = (e->time - now) / frequency + 1;
+      return std::max(e->time - periods * frequency, latest_update_time_);
+    }
+  }
+  return latest_update_time_;
 }
 
 void Person::randomly_choose_target_location() {
@@ -706,7 +722,8 @@ void Person::randomly_choose_target_location() {
   // Report the movement if need be
   if (Model::MODEL->report_movement()) {
     auto person_index = static_cast<int>(PersonIndexAllHandler::index());
-    MovementValidation::add_move(person_index, location_, target_location);
+    MovementValidation::add_move(_uid, person_index, location_,
+                                 target_location);
   }
 
   schedule_move_to_target_location_next_day_event(target_location);
@@ -829,8 +846,9 @@ double Person::prob_present_at_mda() {
 }
 
 bool Person::has_effective_drug_in_blood() const {
-  for (const auto &kv_drug : *drugs_in_blood_->drugs()) {
-    if (kv_drug.second->last_update_value() > 0.5) return true;
-  }
-  return false;
+  auto result = false;
+  drugs_in_blood_->for_each_drug([&result](Drug &drug) {
+    result = result || drug.last_update_value() > 0.5;
+  });
+  return result;
 }
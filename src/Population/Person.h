@@ -31,7 +31,6 @@ class Genotype;
 
 class Event;
 
-class ParasiteDensityUpdateFunction;
 
 class DrugType;
 
@@ -201,8 +200,8 @@ public:
   void cancel_all_events_except(Event* event) const;
 
   void change_all_parasite_update_function(
-      ParasiteDensityUpdateFunction* from,
-      ParasiteDensityUpdateFunction* to) const;
+      ParasiteDensityUpdateFunction from,
+      ParasiteDensityUpdateFunction to) const;
 
   void receive_therapy(Therapy* therapy,
                        ClonalParasitePopulation* clinical_caused_parasite,
@@ -219,7 +218,8 @@ public:
       const int &t_id = 0);
 
   void schedule_update_by_drug_event(
-      ClonalParasitePopulation* clinical_caused_parasite);
+      ClonalParasitePopulation* clinical_caused_parasite,
+      const ul_uid &clinical_caused_parasite_uid);
 
   void schedule_end_clinical_event(
       ClonalParasitePopulation* clinical_caused_parasite);
@@ -238,10 +238,16 @@ public:
 
   void schedule_update_every_K_days_event(const int &time);
 
+  // Return the time of the last update every K days before the current day,
+  // while the updates are deferred this is the update that would have been
+  // made had they not been
+  [[nodiscard]] int last_periodic_update_time() const;
+
   void change_state_when_no_parasite_in_blood();
 
   void determine_relapse_or_not(
-      ClonalParasitePopulation* clinical_caused_parasite);
+      ClonalParasitePopulation* clinical_caused_parasite,
+      const ul_uid &clinical_caused_parasite_uid);
 
   void determine_clinical_or_not(
       ClonalParasitePopulation* clinical_caused_parasite);
@@ -5,12 +5,14 @@
  */
 #include "Population.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 
 #include "Constants.h"
 #include "Core/Config/Config.h"
 #include "Core/Random.h"
+#include "Core/ThreadPool.h"
 #include "Events/BirthdayEvent.h"
 #include "Events/RaptEvent.h"
 #include "Events/SwitchImmuneComponentEvent.h"
@@ -68,6 +70,9 @@ void Population::add_person(Person* person) {
 
   // Update the count at the location
   popsize_by_location_[person->location()]++;
+  if (Model::MAIN_DATA_COLLECTOR != nullptr) {
+    Model::MAIN_DATA_COLLECTOR->record_person_added(person);
+  }
 }
 
 void Population::remove_person(Person* person) {
@@ -84,6 +89,9 @@ void Population::remove_person(Person* person) {
   // Update the count at the location
   popsize_by_location_[person->location()]--;
   assert(popsize_by_location_[person->location()] >= 0);
+  if (Model::MAIN_DATA_COLLECTOR != nullptr) {
+    Model::MAIN_DATA_COLLECTOR->record_person_removed(person);
+  }
 }
 
 void Population::remove_dead_person(Person* person) {
@@ -96,6 +104,40 @@ void Population::notify_change(Person* p, const Person::Property &property,
   for (PersonIndex* person_index : *person_index_list_) {
     person_index->notify_change(p, property, oldValue, newValue);
   }
+
+  // Track the locations with infected hosts
+  if (property == Person::HOST_STATE) {
+    const auto state = *static_cast<const Person::HostStates*>(newValue);
+    if (state != Person::SUSCEPTIBLE && state != Person::DEAD) {
+      mark_active(p->location());
+    }
+  } else if (property == Person::LOCATION) {
+    if (p->host_state() != Person::SUSCEPTIBLE
+        && p->host_state() != Person::DEAD) {
+      mark_active(*static_cast<const int*>(newValue));
+    }
+  }
+
+  // Keep the population counts of the data collector current
+  if (Model::MAIN_DATA_COLLECTOR == nullptr) { return; }
+  switch (property) {
+    case Person::LOCATION:
+      Model::MAIN_DATA_COLLECTOR->record_person_changed(
+          p, *static_cast<const int*>(newValue), p->host_state(), p->age());
+      break;
+    case Person::HOST_STATE:
+      Model::MAIN_DATA_COLLECTOR->record_person_changed(
+          p, p->location(), *static_cast<const Person::HostStates*>(newValue),
+          p->age());
+      break;
+    case Person::AGE:
+      Model::MAIN_DATA_COLLECTOR->record_person_changed(
+          p, p->location(), p->host_state(),
+          *static_cast<const int*>(newValue));
+      break;
+    default:
+      break;
+  }
 }
 
 void Population::notify_movement(const int source, const int destination) {
@@ -110,8 +152,19 @@ std::size_t Population::size(const int &location) {
   return popsize_by_location_[location];
 }
 
+void Population::update_effective_beta() {
+  const auto &location_db = Model::CONFIG->location_db();
+  effective_beta_.resize(Model::CONFIG->number_of_locations());
+  Model::CONFIG->seasonal_info()->get_seasonal_factors(
+      Model::SCHEDULER->calendar_date, effective_beta_);
+  for (std::size_t loc = 0; loc < effective_beta_.size(); loc++) {
+    effective_beta_[loc] *= location_db[loc].beta;
+  }
+}
+
 void Population::perform_infection_event() {
   PersonPtrVector today_infections;
+  std::vector<unsigned long> indices;
 
 #ifdef DEBUG
   auto start = std::chrono::system_clock::now();
@@ -120,13 +173,11 @@ void Population::perform_infection_event() {
   // Get the person index
   auto pi = get_person_index<PersonIndexByLocationBitingLevel>();
 
-  // Iterate over all the locations in the model
-  for (auto loc = 0; loc < Model::CONFIG->number_of_locations(); loc++) {
-    // Calculate location adjustments
-
-    const auto new_beta = Model::CONFIG->location_db()[loc].beta
-                          * Model::CONFIG->seasonal_info()->get_seasonal_factor(
-                              Model::SCHEDULER->calendar_date, loc);
+  // Iterate over the locations where there may be transmission, the force of
+  // infection is zero elsewhere
+  for (auto loc : active_locations_) {
+    // Location adjustments are computed for the day by update_effective_beta
+    const auto new_beta = effective_beta_[loc];
 
     // Iterate over all the parasite types
     for (std::size_t parasite_type_id = 0;
@@ -170,9 +221,11 @@ void Population::perform_infection_event() {
         const auto size = pi->vPerson()[loc][biting_level].size();
         if (size == 0) { continue; }
 
-        for (std::size_t j = 0u; j < v_int_number_of_bites[biting_level]; j++) {
-          // select 1 random person from level i
-          const auto index = model_->random()->random_uniform(size);
+        // select the random people from level i, with replacement
+        const auto bites = v_int_number_of_bites[biting_level];
+        indices.resize(bites);
+        model_->random()->fill_uniform_int(size, indices.data(), bites);
+        for (auto index : indices) {
           auto* person = pi->vPerson()[loc][biting_level][index];
 
           // If the person is not dead, inflict the bite upon them,
@@ -226,6 +279,10 @@ void Population::initialize() {
       DoubleVector2(number_of_location,
                     DoubleVector(number_of_parasite_type, 0));
 
+  is_active_.assign(number_of_location, false);
+  active_locations_.clear();
+  activated_.clear();
+
   force_of_infection_for7days_by_location_parasite_type_ =
       std::vector<DoubleVector2>(
           Model::CONFIG->number_of_tracking_days(),
@@ -235,8 +292,14 @@ void Population::initialize() {
   // Initialize other person index
   initialize_person_indices();
 
-  // Initialize population
+  // Initialize population, the random attributes of the individuals are drawn
+  // in batches for each location and age class
   auto &location_db = Model::CONFIG->location_db();
+  const auto &immune_information = Model::CONFIG->immune_system_information();
+  std::vector<unsigned long> ages;
+  std::vector<unsigned long> days_to_next_birthday;
+  std::vector<double> immune_values;
+  std::vector<unsigned long> update_times;
   for (auto loc = 0; loc < number_of_location; loc++) {
     VLOG(9) << fmt::format("Cell {}, population {}", loc,
                            location_db[loc].population_size);
@@ -256,14 +319,47 @@ void Population::initialize() {
             popsize_by_location * location_db[loc].age_distribution[age_class]);
         temp_sum += number_of_individual_by_loc_ageclass;
       }
-      for (int i = 0; i < number_of_individual_by_loc_ageclass; i++) {
-        generate_individual(loc, age_class);
+      if (number_of_individual_by_loc_ageclass <= 0) { continue; }
+      const auto count =
+          static_cast<std::size_t>(number_of_individual_by_loc_ageclass);
+
+      // Note that we are defining the types to conform to the signature of
+      // fill_uniform_int
+      unsigned long age_from =
+          (age_class == 0)
+              ? 0
+              : Model::CONFIG->initial_age_structure()[age_class - 1];
+      unsigned long age_to = Model::CONFIG->initial_age_structure()[age_class];
+      ages.resize(count);
+      days_to_next_birthday.resize(count);
+      immune_values.resize(count);
+      update_times.resize(count);
+      Model::RANDOM->fill_uniform_int(age_to + 1 - age_from, ages.data(),
+                                      count);
+      Model::RANDOM->fill_uniform_int(
+          static_cast<unsigned long>(Constants::DAYS_IN_YEAR()),
+          days_to_next_birthday.data(), count);
+      for (std::size_t i = 0; i < count; i++) {
+        immune_values[i] = Model::RANDOM->random_beta(
+            immune_information.alpha_immune, immune_information.beta_immune);
+      }
+      Model::RANDOM->fill_uniform_int(Model::CONFIG->update_frequency(),
+                                      update_times.data(), count);
+
+      for (std::size_t i = 0; i < count; i++) {
+        generate_individual(loc, static_cast<int>(age_from + ages[i]),
+                            static_cast<int>(days_to_next_birthday[i]),
+                            immune_values[i],
+                            static_cast<int>(update_times[i] + 1));
       }
     }
   }
 }
 
-void Population::generate_individual(int location, int age_class) {
+void Population::generate_individual(int location, int age,
+                                     int days_to_next_birthday,
+                                     double immune_value,
+                                     int first_update_time) {
   auto p = new Person();
   p->init();
 
@@ -271,17 +367,9 @@ void Population::generate_individual(int location, int age_class) {
   p->set_residence_location(location);
   p->set_host_state(Person::SUSCEPTIBLE);
 
-  // Set the age of the individual, which also sets the age class. Note that we
-  // are defining the types to conform to the signature of random_uniform_int
-  unsigned long age_from =
-      (age_class == 0) ? 0
-                       : Model::CONFIG->initial_age_structure()[age_class - 1];
-  unsigned long age_to = Model::CONFIG->initial_age_structure()[age_class];
-  p->set_age(static_cast<int>(
-      Model::RANDOM->random_uniform_int(age_from, age_to + 1)));
-
-  auto days_to_next_birthday = static_cast<int>(Model::RANDOM->random_uniform(
-      static_cast<unsigned long>(Constants::DAYS_IN_YEAR())));
+  // Set the age of the individual, which also sets the age class
+  p->set_age(age);
+
   auto simulation_time_birthday = TimeHelpers::get_simulation_time_birthday(
       days_to_next_birthday, p->age(), Model::SCHEDULER->calendar_date);
   p->set_birthday(simulation_time_birthday);
@@ -306,9 +394,6 @@ void Population::generate_individual(int location, int age_class) {
     p->immune_system()->set_immune_component(new NonInfantImmuneComponent());
   }
 
-  auto immune_value = Model::RANDOM->random_beta(
-      Model::CONFIG->immune_system_information().alpha_immune,
-      Model::CONFIG->immune_system_information().beta_immune);
   p->immune_system()->immune_component()->set_latest_value(immune_value);
   p->immune_system()->set_increase(false);
 
@@ -323,9 +408,7 @@ void Population::generate_individual(int location, int age_class) {
 
   p->set_latest_update_time(0);
 
-  auto time = static_cast<int>(
-      Model::RANDOM->random_uniform(Model::CONFIG->update_frequency()) + 1);
-  p->schedule_update_every_K_days_event(time);
+  p->schedule_update_every_K_days_event(first_update_time);
   p->generate_prob_present_at_mda_by_age();
 
   add_person(p);
@@ -372,6 +455,7 @@ void Population::introduce_initial_cases() {
       }
     }
   }
+  update_active_locations(true);
 }
 
 void Population::introduce_parasite(const int &location,
@@ -430,13 +514,13 @@ void Population::initial_infection(Person* person,
   if (p < p_clinical) {
     // progress to clinical after several days
     blood_parasite->set_update_function(
-        model_->progress_to_clinical_update_function());
+        ParasiteDensityUpdateFunction::PROGRESS_TO_CLINICAL);
     person->schedule_progress_to_clinical_event_by(blood_parasite);
   } else {
     // only progress to clearance by Immune system
     // progress to clearance
     blood_parasite->set_update_function(
-        model_->immunity_clearance_update_function());
+        ParasiteDensityUpdateFunction::IMMUNITY_CLEARANCE);
   }
 }
 
@@ -446,12 +530,16 @@ void Population::notify_change_in_force_of_infection(
   current_force_of_infection_by_location_parasite_type_[location]
                                                        [parasite_type_id] +=
       relative_force_of_infection;
+  mark_active(location);
 }
 
 void Population::update_force_of_infection(const int &current_time) {
+  // Include the locations that became active today, the force of infection
+  // of the inactive locations is zero so they can be skipped
+  update_active_locations(false);
   perform_interrupted_feeding_recombination();
 
-  for (std::size_t loc = 0; loc < Model::CONFIG->number_of_locations(); loc++) {
+  for (auto loc : active_locations_) {
     for (std::size_t p_type = 0;
          p_type < Model::CONFIG->number_of_parasite_types(); p_type++) {
       force_of_infection_for7days_by_location_parasite_type()
@@ -461,6 +549,48 @@ void Population::update_force_of_infection(const int &current_time) {
                   [loc][p_type];
     }
   }
+  update_active_locations(true);
+}
+
+void Population::update_active_locations(bool remove_inactive) {
+  if (!activated_.empty()) {
+    active_locations_.insert(active_locations_.end(), activated_.begin(),
+                             activated_.end());
+    std::sort(active_locations_.begin(), active_locations_.end());
+    activated_.clear();
+  }
+  if (!remove_inactive) { return; }
+
+  // A location remains active while any infected host is present or any
+  // force of infection remains in the tracking period
+  auto pi = get_person_index<PersonIndexByLocationStateAgeClass>();
+  const auto is_zero = [](const DoubleVector &values) {
+    return std::all_of(values.begin(), values.end(),
+                       [](double value) { return value == 0.0; });
+  };
+  const auto is_inactive = [&](int loc) {
+    if (!is_zero(current_force_of_infection_by_location_parasite_type_[loc])
+        || !is_zero(
+            interupted_feeding_force_of_infection_by_location_parasite_type_
+                [loc])) {
+      return false;
+    }
+    for (const auto &day :
+         force_of_infection_for7days_by_location_parasite_type_) {
+      if (!is_zero(day[loc])) { return false; }
+    }
+    for (auto hs = static_cast<int>(Person::EXPOSED);
+         hs <= static_cast<int>(Person::CLINICAL); hs++) {
+      for (const auto &persons : pi->vPerson()[loc][hs]) {
+        if (!persons.empty()) { return false; }
+      }
+    }
+    is_active_[loc] = false;
+    return true;
+  };
+  active_locations_.erase(std::remove_if(active_locations_.begin(),
+                                         active_locations_.end(), is_inactive),
+                          active_locations_.end());
 }
 
 // Free space in the population indicies.
@@ -471,12 +601,20 @@ void Population::update() {
 }
 
 void Population::perform_birth_event() {
-  for (auto loc = 0; loc < Model::CONFIG->number_of_locations(); loc++) {
-    auto poisson_means = static_cast<double>(size(loc))
+  // Draw the number of births for all of the locations at once
+  const auto number_of_locations = Model::CONFIG->number_of_locations();
+  std::vector<double> poisson_means(number_of_locations);
+  std::vector<int> births(number_of_locations);
+  for (auto loc = 0; loc < number_of_locations; loc++) {
+    poisson_means[loc] = static_cast<double>(size(loc))
                          * Model::CONFIG->birth_rate()
                          / Constants::DAYS_IN_YEAR();
-    const auto number_of_births = Model::RANDOM->random_poisson(poisson_means);
-    for (int i = 0; i < number_of_births; i++) {
+  }
+  Model::RANDOM->fill_poisson(poisson_means.data(), births.data(),
+                              number_of_locations);
+
+  for (auto loc = 0; loc < number_of_locations; loc++) {
+    for (int i = 0; i < births[loc]; i++) {
       give_1_birth(loc);
       Model::MAIN_DATA_COLLECTOR->record_1_birth(loc);
       Model::MAIN_DATA_COLLECTOR->update_person_days_by_years(
@@ -541,37 +679,56 @@ void Population::perform_death_event() {
 
   PersonPtrVector deceased;
 
+  // The number of deaths for the non-empty buckets (age class and state) in a
+  // location is drawn at once, deaths only move people to the dead state so
+  // the sizes of the other buckets do not change while the deaths are applied
+  const auto number_of_age_classes = Model::CONFIG->number_of_age_classes();
+  std::vector<std::pair<std::size_t, std::size_t>> buckets;
+  std::vector<double> poisson_means;
+  std::vector<int> deaths;
+  std::vector<unsigned long> indices;
+
   // Iterate over the locations, age brackets, and states
   for (std::size_t loc = 0; loc < Model::CONFIG->number_of_locations(); loc++) {
-    for (std::size_t ac = 0; ac < Model::CONFIG->number_of_age_classes();
-         ac++) {
+    buckets.clear();
+    poisson_means.clear();
+    for (std::size_t ac = 0; ac < number_of_age_classes; ac++) {
+      // Note the dead state is last, so it is excluded by the bound
       for (std::size_t hs = 0; hs < Person::NUMBER_OF_STATE - 1; hs++) {
-        // Skip the dead state for the outer scan
-        if (hs == Person::DEAD) { continue; }
-
         // Press on if there is nothing to do
         auto size = pi->vPerson()[loc][hs][ac].size();
         if (size == 0) { continue; }
 
-        // Determine the number of deaths, press on if there are none
-        auto poisson_means = static_cast<double>(size)
-                             * Model::CONFIG->death_rate_by_age_class()[ac]
-                             / Constants::DAYS_IN_YEAR();
-        const auto number_of_deaths =
-            Model::RANDOM->random_poisson(poisson_means);
-        if (number_of_deaths == 0) { continue; }
-
-        // Change the state for the number of deaths based upon the actuarial
-        // likelihood
-        for (int i = 0; i < number_of_deaths; i++) {
-          auto index = Model::RANDOM->random_uniform(size);
-          auto* p = pi->vPerson()[loc][hs][ac][index];
-          p->cancel_all_events_except(nullptr);
-          p->set_host_state(Person::DEAD);
-        }
+        buckets.emplace_back(ac, hs);
+        poisson_means.push_back(static_cast<double>(size)
+                                * Model::CONFIG->death_rate_by_age_class()[ac]
+                                / Constants::DAYS_IN_YEAR());
+      }
+    }
+    deaths.resize(buckets.size());
+    Model::RANDOM->fill_poisson(poisson_means.data(), deaths.data(),
+                                buckets.size());
+
+    for (std::size_t ndx = 0; ndx < buckets.size(); ndx++) {
+      // Press on if there are no deaths
+      const auto number_of_deaths = deaths[ndx];
+      if (number_of_deaths == 0) { continue; }
+      const auto [ac, hs] = buckets[ndx];
+      auto size = pi->vPerson()[loc][hs][ac].size();
+
+      // Change the state for the number of deaths based upon the actuarial
+      // likelihood
+      indices.resize(number_of_deaths);
+      Model::RANDOM->fill_uniform_int(size, indices.data(), number_of_deaths);
+      for (auto index : indices) {
+        auto* p = pi->vPerson()[loc][hs][ac][index];
+        p->cancel_all_events_except(nullptr);
+        p->set_host_state(Person::DEAD);
       }
+    }
 
-      // Scan for any deceased people
+    // Scan for any deceased people
+    for (std::size_t ac = 0; ac < number_of_age_classes; ac++) {
       for (auto person : pi->vPerson()[loc][Person::DEAD][ac]) {
         deceased.push_back(person);
       }
@@ -593,59 +750,79 @@ void Population::perform_circulation_event() {
       Model::CONFIG->circulation_info().circulation_percent;
   if (circulation_percent == 0.0) { return; }
 
-  PersonPtrVector today_circulations;
-
-  // Grab a copy of residents by location
-  const auto residents_by_location =
-      Model::MAIN_DATA_COLLECTOR->popsize_residence_by_location();
+  // Note the residents by location, the spatial model only recomputes the
+  // movement distributions when these have changed (i.e., monthly)
+  auto* spatial_model = Model::CONFIG->spatial_model();
+  spatial_model->update_residents_by_location(
+      Model::MAIN_DATA_COLLECTOR->popsize_residence_by_location());
+
+  // The source locations are independent of each other, each one draws from
+  // its own substream and the individuals selected only belong to that source,
+  // so they are divided into chunks that are run in parallel with a list of
+  // travellers for each chunk
+  const auto locations =
+      static_cast<std::size_t>(Model::CONFIG->number_of_locations());
+  const auto day = static_cast<std::uint32_t>(Model::SCHEDULER->current_time());
+  std::vector<PersonPtrVector> circulations(
+      ThreadPool::chunk_count(locations, CIRCULATION_GRAIN));
 
   // for each location
   //  get number of circulations based on size * circulation_percent
   //  distributes that number into others location based of other location size
   //  for each number in that list select an individual, and schedule a movement
   //  event on next day
-  for (auto from_location = 0;
-       from_location < Model::CONFIG->number_of_locations(); from_location++) {
-    // How much of the population is moving? If none then press on
-    auto poisson_means =
-        static_cast<double>(size(from_location)) * circulation_percent;
-    if (poisson_means == 0) { continue; }
-    const auto number_of_circulating_from_this_location =
-        Model::RANDOM->random_poisson(poisson_means);
-    if (number_of_circulating_from_this_location == 0) { continue; }
-
-    DoubleVector v_relative_outmovement_to_destination(
-        Model::CONFIG->number_of_locations(), 0);
-    v_relative_outmovement_to_destination =
-        Model::CONFIG->spatial_model()
-            ->get_v_relative_out_movement_to_destination(
-                from_location,
-                static_cast<int>(Model::CONFIG->number_of_locations()),
-                Model::CONFIG->spatial_distance_matrix()[from_location],
-                residents_by_location);
-
-    std::vector<unsigned int> v_num_leavers_to_destination(
-        static_cast<unsigned long long int>(
-            Model::CONFIG->number_of_locations()));
-    Model::RANDOM->random_multinomial(
-        static_cast<int>(v_relative_outmovement_to_destination.size()),
-        static_cast<unsigned int>(number_of_circulating_from_this_location),
-        &v_relative_outmovement_to_destination[0],
-        &v_num_leavers_to_destination[0]);
-
-    for (auto target_location = 0;
-         target_location < Model::CONFIG->number_of_locations();
-         target_location++) {
-      if (v_num_leavers_to_destination[target_location] == 0) { continue; }
-      perform_circulation_for_1_location(
-          from_location, target_location,
-          static_cast<int>(v_num_leavers_to_destination[target_location]),
-          today_circulations);
-    }
-  }
+  Model::THREAD_POOL->parallel_for(
+      locations, CIRCULATION_GRAIN,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        DoubleVector uniforms;
+        IntVector destinations;
+        for (auto from_location = static_cast<int>(begin);
+             from_location < static_cast<int>(end); from_location++) {
+          // How much of the population is moving? If none then press on
+          auto poisson_means =
+              static_cast<double>(size(from_location)) * circulation_percent;
+          if (poisson_means == 0) { continue; }
+          auto random = Model::RANDOM->substream(RandomPhase::CIRCULATION,
+                                                 from_location, day);
+          const auto number_of_circulating_from_this_location =
+              random.random_poisson(poisson_means);
+          if (number_of_circulating_from_this_location == 0) { continue; }
+
+          // Draw the destination of each traveller, this is equivalent to a
+          // multinomial over the locations but costs O(log L) per traveller
+          uniforms.resize(number_of_circulating_from_this_location);
+          destinations.resize(number_of_circulating_from_this_location);
+          random.fill_uniform(uniforms.data(), uniforms.size());
+          for (std::size_t ndx = 0; ndx < uniforms.size(); ndx++) {
+            destinations[ndx] =
+                spatial_model->sample_destination(from_location, uniforms[ndx]);
+          }
+          std::sort(destinations.begin(), destinations.end());
+
+          // Move the travellers to each destination in turn, those without a
+          // destination (-1) are sorted first and skipped
+          auto first = static_cast<std::size_t>(
+              std::lower_bound(destinations.begin(), destinations.end(), 0)
+              - destinations.begin());
+          while (first < destinations.size()) {
+            auto last = first + 1;
+            while (last < destinations.size()
+                   && destinations[last] == destinations[first]) {
+              last++;
+            }
+            perform_circulation_for_1_location(
+                from_location, destinations[first],
+                static_cast<int>(last - first), circulations[chunk], &random);
+            first = last;
+          }
+        }
+      });
 
-  // Have the population do the movement
-  for (auto* p : today_circulations) { p->randomly_choose_target_location(); }
+  // Have the population do the movement, the chunks are merged in order so
+  // the events are scheduled in the same order regardless of the threads
+  for (const auto &chunk : circulations) {
+    for (auto* p : chunk) { p->randomly_choose_target_location(); }
+  }
 
 #ifdef DEBUG
   auto end = std::chrono::system_clock::now();
@@ -658,8 +835,8 @@ void Population::perform_circulation_event() {
 
 void Population::perform_circulation_for_1_location(
     const int &from_location, const int &target_location,
-    const int &number_of_circulation,
-    std::vector<Person*> &today_circulations) {
+    const int &number_of_circulation, std::vector<Person*> &today_circulations,
+    Random* random) {
   DoubleVector vLevelDensity;
   auto pi = get_person_index<PersonIndexByLocationMovingLevel>();
 
@@ -672,7 +849,7 @@ void Population::perform_circulation_for_1_location(
 
   std::vector<unsigned int> vIntNumberOfCirculation(vLevelDensity.size());
 
-  model_->random()->random_multinomial(
+  random->random_multinomial(
       static_cast<int>(vLevelDensity.size()),
       static_cast<unsigned int>(number_of_circulation), &vLevelDensity[0],
       &vIntNumberOfCirculation[0]);
@@ -684,14 +861,14 @@ void Population::perform_circulation_for_1_location(
     if (size == 0) continue;
     for (std::size_t j = 0u; j < vIntNumberOfCirculation[moving_level]; j++) {
       // select 1 random person from level i
-      auto index = model_->random()->random_uniform(size);
+      auto index = random->random_uniform(size);
       Person* p = pi->vPerson()[from_location][moving_level][index];
       assert(p->host_state() != Person::DEAD);
 
       if (p->host_state() == Person::CLINICAL) {
         auto prob = Model::CONFIG->circulation_info()
                         .relative_probability_for_clinical_to_travel;
-        if (prob < 1.0 && model_->random()->random_flat(0, 1) > prob) {
+        if (prob < 1.0 && random->random_flat(0, 1) > prob) {
           // that person does not move due to having clinical symptoms
           continue;
         }
@@ -703,7 +880,7 @@ void Population::perform_circulation_for_1_location(
         auto prob =
             Model::CONFIG->circulation_info()
                 .relative_probability_that_child_travels_compared_to_adult;
-        if (prob < 1.0 && model_->random()->random_flat(0, 1) > prob) {
+        if (prob < 1.0 && random->random_flat(0, 1) > prob) {
           // that child does not move
           continue;
         }
@@ -740,9 +917,10 @@ void Population::initialize_person_indices() {
 // TODO Re-evaluate this code with version 5.0 to determine if it is still
 // needed.
 void Population::perform_interrupted_feeding_recombination() {
-  // Cache some values
+  // Cache some values, the values below are computed for the active
+  // locations only since the force of infection is zero elsewhere
   auto parasite_types = Model::CONFIG->number_of_parasite_types();
-  auto number_of_locations = Model::CONFIG->number_of_locations();
+  auto number_of_locations = active_locations_.size();
 
   // calculate vector Y, Z
   auto y =
@@ -752,18 +930,19 @@ void Population::perform_interrupted_feeding_recombination() {
       DoubleVector2(static_cast<unsigned long long int>(number_of_locations),
                     DoubleVector(parasite_types, 0));
 
-  for (std::size_t loc = 0; loc < number_of_locations; loc++) {
+  for (std::size_t ndx = 0; ndx < number_of_locations; ndx++) {
+    const auto loc = active_locations_[ndx];
     for (std::size_t parasite_type_id = 0; parasite_type_id < parasite_types;
          parasite_type_id++) {
       interupted_feeding_force_of_infection_by_location_parasite_type_
           [loc][parasite_type_id] =
               current_force_of_infection_by_location_parasite_type_
                   [loc][parasite_type_id];
-      y[loc][parasite_type_id] =
+      y[ndx][parasite_type_id] =
           interupted_feeding_force_of_infection_by_location_parasite_type_
               [loc][parasite_type_id]
           * (1 - Model::CONFIG->fraction_mosquitoes_interrupted_feeding());
-      z[loc][parasite_type_id] =
+      z[ndx][parasite_type_id] =
           interupted_feeding_force_of_infection_by_location_parasite_type_
               [loc][parasite_type_id]
           * Model::CONFIG->fraction_mosquitoes_interrupted_feeding();
@@ -774,7 +953,7 @@ void Population::perform_interrupted_feeding_recombination() {
 
   auto pi =
       Model::POPULATION->get_person_index<PersonIndexByLocationStateAgeClass>();
-  for (std::size_t loc = 0; loc < number_of_locations; loc++) {
+  for (auto loc : active_locations_) {
     // hs 2: asymptomatic, 3: clinical
     for (std::size_t hs = 2; hs <= 3; hs++) {
       for (std::size_t ac = 0; ac < Model::CONFIG->number_of_age_classes();
@@ -834,14 +1013,10 @@ void Population::perform_interrupted_feeding_recombination() {
             eafar[loc][i] += weight;
           } else {
             const auto weight = 2 * z[loc][i] * z[loc][j];
-            for (auto p = 0; p < parasite_types; p++) {
-              if (Model::CONFIG->genotype_db()->get_offspring_density(i, j, p)
-                  == 0)
-                continue;
-              eafar[loc][p] +=
-                  weight
-                  * Model::CONFIG->genotype_db()->get_offspring_density(i, j,
-                                                                        p);
+            for (const auto &offspring :
+                 Model::CONFIG->genotype_db()->get_offspring_distribution(i,
+                                                                          j)) {
+              eafar[loc][offspring.genotype_id] += weight * offspring.density;
             }
           }
         }
@@ -870,11 +1045,12 @@ void Population::perform_interrupted_feeding_recombination() {
           static_cast<const int &>(eafar[loc].size()),
           static_cast<const unsigned int &>(sum_z), &eafar[loc][0], &new_z[0]);
 
+      const auto location = active_locations_[loc];
       for (std::size_t parasite_type_id = 0; parasite_type_id < parasite_types;
            parasite_type_id++) {
         z[loc][parasite_type_id] = new_z[parasite_type_id] / a;
         interupted_feeding_force_of_infection_by_location_parasite_type_
-            [loc][parasite_type_id] =
+            [location][parasite_type_id] =
                 y[loc][parasite_type_id] + z[loc][parasite_type_id];
 
         // This new_z value has been used, so clear it
@@ -18,6 +18,7 @@ class Model;
 class PersonIndexAll;
 class PersonIndexByLocationStateAgeClass;
 class PersonIndexByLocationBitingLevel;
+class Random;
 
 /**
  * Population will manage the life cycle of Person object it will release/delete
@@ -41,9 +42,38 @@ class Population : public Dispatcher {
   // Population size currently in the location
   PROPERTY_REF(IntVector, popsize_by_location)
 
+  // Beta adjusted by the seasonal factor for each location, updated daily
+  READ_ONLY_PROPERTY_REF(DoubleVector, effective_beta)
+
+  // Locations, in ascending order, with an infected host or a non-zero force
+  // of infection in the tracking period. Only these locations can transmit, so
+  // the daily transmission steps are limited to them.
+  READ_ONLY_PROPERTY_REF(IntVector, active_locations)
+
 private:
-  // Generate the individual at the given location
-  void generate_individual(int location, int age_class);
+  // Flag for the active locations, including those activated since the last
+  // update, and the locations activated since the last update
+  std::vector<bool> is_active_;
+  IntVector activated_;
+
+  // Mark the location as active, it is added at the next update
+  void mark_active(int location) {
+    if (is_active_.empty() || is_active_[location]) { return; }
+    is_active_[location] = true;
+    activated_.push_back(location);
+  }
+
+  // Add the locations activated since the last update, then remove those
+  // that no longer have infected hosts or a force of infection
+  void update_active_locations(bool remove_inactive);
+
+  // Number of source locations in each chunk of the parallel circulation step
+  static constexpr std::size_t CIRCULATION_GRAIN = 64;
+
+  // Generate the individual at the given location, the random attributes of
+  // the individual are drawn in batches by the caller
+  void generate_individual(int location, int age, int days_to_next_birthday,
+                           double immune_value, int first_update_time);
 
   void give_1_birth(const int &location);
 
@@ -54,10 +84,12 @@ private:
   void introduce_parasite(const int &location, Genotype* parasite_type,
                           const int &num_of_infections);
 
+  // Select the individuals that circulate from the source to the target using
+  // the random stream for the source
   void perform_circulation_for_1_location(
       const int &from_location, const int &target_location,
       const int &number_of_circulation,
-      std::vector<Person*> &today_circulations);
+      std::vector<Person*> &today_circulations, Random* random);
 
   void perform_interrupted_feeding_recombination();
 
@@ -98,6 +130,16 @@ public:
   /** Return the total number of individuals in the given location. */
   virtual std::size_t size(const int &location);
 
+  // Return true if there are no infected hosts and the force of infection for
+  // the tracking period is zero everywhere
+  [[nodiscard]] bool is_free_of_parasites() const {
+    return active_locations_.empty() && activated_.empty();
+  }
+
+  // Update the environment dependent values for the day before the
+  // population events are performed
+  void update_effective_beta();
+
   virtual void perform_infection_event();
 
   virtual void initialize();
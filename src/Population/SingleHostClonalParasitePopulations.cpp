@@ -6,45 +6,43 @@
 #include "SingleHostClonalParasitePopulations.h"
 
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <new>
 
 #include "ClonalParasitePopulation.h"
 #include "Core/Config/Config.h"
 #include "Core/Random.h"
+#include "Core/Scheduler.h"
 #include "DrugsInBlood.h"
 #include "Helpers/NumberHelpers.hxx"
 #include "Helpers/ObjectHelpers.h"
+#include "ImmuneSystem.h"
 #include "MDC/MainDataCollector.h"
 #include "Model.h"
 #include "Parasites/Genotype.h"
 #include "Person.h"
 #include "Therapies/Drug.h"
+#include "Therapies/DrugType.h"
 
 OBJECTPOOL_IMPL(SingleHostClonalParasitePopulations)
 
 SingleHostClonalParasitePopulations::SingleHostClonalParasitePopulations(
     Person* person)
     : person_(person),
-      parasites_(nullptr),
       relative_effective_parasite_density_(nullptr),
       log10_total_relative_density_(
           ClonalParasitePopulation::LOG_ZERO_PARASITE_DENSITY) {}
 
 void SingleHostClonalParasitePopulations::init() {
-  parasites_ = new std::vector<ClonalParasitePopulation*>();
   if (Model::CONFIG != nullptr) {
     parasite_types =
         static_cast<int>(Model::CONFIG->number_of_parasite_types());
-    relative_effective_parasite_density_ =
-        new DoubleVector(parasite_types, 0.0);
   }
 }
 
 SingleHostClonalParasitePopulations::~SingleHostClonalParasitePopulations() {
-  if (parasites_ != nullptr) {
-    clear();
-    ObjectHelpers::delete_pointer<std::vector<ClonalParasitePopulation*>>(
-        parasites_);
-  }
+  clear();
 
   ObjectHelpers::delete_pointer<std::vector<double>>(
       relative_effective_parasite_density_);
@@ -52,41 +50,84 @@ SingleHostClonalParasitePopulations::~SingleHostClonalParasitePopulations() {
   person_ = nullptr;
 }
 
+ClonalParasitePopulation* SingleHostClonalParasitePopulations::allocate_clone(
+    Genotype* genotype) {
+  for (auto slot = 0; slot < INLINE_CLONES; slot++) {
+    if ((clone_slots_ & (1U << slot)) != 0) { continue; }
+    clone_slots_ |= (1U << slot);
+    return new (clone_storage_ + slot * sizeof(ClonalParasitePopulation))
+        ClonalParasitePopulation(genotype);
+  }
+  return new ClonalParasitePopulation(genotype);
+}
+
+void SingleHostClonalParasitePopulations::release_clone(
+    ClonalParasitePopulation* clone) {
+  // Clones outside of the inline storage were allocated on the heap
+  const auto offset = reinterpret_cast<std::uintptr_t>(clone)
+                      - reinterpret_cast<std::uintptr_t>(clone_storage_);
+  if (offset >= sizeof(clone_storage_)) {
+    delete clone;
+    return;
+  }
+
+  clone->~ClonalParasitePopulation();
+  clone_slots_ &= ~(1U << (offset / sizeof(ClonalParasitePopulation)));
+}
+
+void SingleHostClonalParasitePopulations::release_density_when_empty() {
+  if (!parasites_.empty()) { return; }
+  ObjectHelpers::delete_pointer<std::vector<double>>(
+      relative_effective_parasite_density_);
+  log10_total_relative_density_ =
+      ClonalParasitePopulation::LOG_ZERO_PARASITE_DENSITY;
+}
+
 void SingleHostClonalParasitePopulations::clear() {
-  if (parasites_->empty()) return;
+  if (parasites_.empty()) return;
   remove_all_infection_force();
 
-  for (auto &parasite : *parasites_) { delete parasite; }
-  parasites_->clear();
+  for (auto* parasite : parasites_) { release_clone(parasite); }
+  parasites_.clear();
+  release_density_when_empty();
 }
 
-void SingleHostClonalParasitePopulations::add(
-    ClonalParasitePopulation* blood_parasite) {
+ClonalParasitePopulation* SingleHostClonalParasitePopulations::add(
+    Genotype* genotype) {
+  // The relative density by genotype is needed once the host is infected
+  if (relative_effective_parasite_density_ == nullptr && parasite_types > 0) {
+    relative_effective_parasite_density_ =
+        new DoubleVector(parasite_types, 0.0);
+  }
+
+  auto* blood_parasite = allocate_clone(genotype);
   blood_parasite->set_parasite_population(this);
 
-  parasites_->push_back(blood_parasite);
-  blood_parasite->set_index(parasites_->size() - 1);
-  assert(parasites_->at(blood_parasite->index()) == blood_parasite);
+  parasites_.push_back(blood_parasite);
+  blood_parasite->set_index(parasites_.size() - 1);
+  assert(parasites_.at(blood_parasite->index()) == blood_parasite);
+
+  return blood_parasite;
 }
 
 // Remove the parasite at the given index from the population, does not
 // recalculate the infection force.
 void SingleHostClonalParasitePopulations::remove(const std::size_t &index) {
-  ClonalParasitePopulation* bp = parasites_->at(index);
+  ClonalParasitePopulation* bp = parasites_.at(index);
   if (bp->index() != index) {
     std::cout << bp->index() << "-" << index << "-"
-              << parasites_->at(index)->index() << std::endl;
+              << parasites_.at(index)->index() << std::endl;
     assert(bp->index() == index);
   }
 
-  parasites_->back()->set_index(index);
-  parasites_->at(index) = parasites_->back();
-  parasites_->pop_back();
+  parasites_.back()->set_index(index);
+  parasites_.at(index) = parasites_.back();
+  parasites_.pop_back();
   bp->set_index(-1);
 
   bp->set_parasite_population(nullptr);
 
-  delete bp;
+  release_clone(bp);
 }
 
 void SingleHostClonalParasitePopulations::remove_all_infection_force() {
@@ -106,8 +147,10 @@ void SingleHostClonalParasitePopulations::add_all_infection_force() {
 
 void SingleHostClonalParasitePopulations::change_all_infection_force(
     const double &sign) {
-  // Return if there isn't a person
-  if (person_ == nullptr) { return; }
+  // Return if there isn't a person, or they are not infected
+  if (person_ == nullptr || relative_effective_parasite_density_ == nullptr) {
+    return;
+  }
 
   // Return if the density is zero
   if (NumberHelpers::is_equal(
@@ -145,7 +188,7 @@ void SingleHostClonalParasitePopulations::
   // Update the current values
   for (std::size_t i = 0; i < relative_parasite_density.size(); i++) {
     if (NumberHelpers::is_zero(relative_parasite_density[i])) { continue; }
-    auto index = (*parasites_)[i]->genotype()->genotype_id();
+    auto index = parasites_[i]->genotype()->genotype_id();
     (*relative_effective_parasite_density_)[index] +=
         relative_parasite_density[i];
   }
@@ -192,32 +235,27 @@ void SingleHostClonalParasitePopulations::
       // Are they the same?
       if (i == j) {
         const auto weight = density_i * density_i;
-        const auto index = (*parasites_)[i]->genotype()->genotype_id();
+        const auto index = parasites_[i]->genotype()->genotype_id();
         (*relative_effective_parasite_density_)[index] += weight;
         continue;
       }
 
       // Different, more complicated update
       const auto weight = 2 * density_i * density_j;
-      const auto id_f = (*parasites_)[i]->genotype()->genotype_id();
-      const auto id_m = (*parasites_)[j]->genotype()->genotype_id();
-      for (auto p = 0; p < parasite_types; p++) {
-        // Check to see if a call to get_offspring_density is needed, if the
-        // indices are the same then we know the value is zero (no change), or
-        // one (update with weight)
-        if (id_f == id_m) {
-          if (id_f == p) {
-            (*relative_effective_parasite_density_)[p] += weight;
-          }
-        } else {
-          // Check the density matrix and use that to ensure that the right
-          // weight is applied to the update
-          auto offspring_density =
-              (id_f < id_m) ? genotype_db->mating_matrix->get(id_m, id_f, p)
-                            : genotype_db->mating_matrix->get(id_f, id_m, p);
-          (*relative_effective_parasite_density_)[p] +=
-              weight * offspring_density;
-        }
+      const auto id_f = parasites_[i]->genotype()->genotype_id();
+      const auto id_m = parasites_[j]->genotype()->genotype_id();
+
+      // If the genotypes are the same then the only offspring is the parent
+      if (id_f == id_m) {
+        (*relative_effective_parasite_density_)[id_f] += weight;
+        continue;
+      }
+
+      // Otherwise apply the weight to the non-zero offspring of the mating
+      for (const auto &offspring :
+           genotype_db->get_offspring_distribution(id_m, id_f)) {
+        (*relative_effective_parasite_density_)[offspring.genotype_id] +=
+            weight * offspring.density;
       }
     }
   }
@@ -227,13 +265,13 @@ void SingleHostClonalParasitePopulations::get_parasites_profiles(
     std::vector<double> &relative_parasite_density,
     double &log10_total_relative_density) const {
   // Note the size once
-  std::size_t size = parasites_->size();
+  std::size_t size = parasites_.size();
 
   // Scan the densities to see if they are all zero
   std::size_t i = 0;
   while ((i < size)
          && (NumberHelpers::is_equal(
-             (*parasites_)[i]->get_log10_relative_density(),
+             parasites_[i]->get_log10_relative_density(),
              ClonalParasitePopulation::LOG_ZERO_PARASITE_DENSITY))) {
     relative_parasite_density[i] = 0.0;
     i++;
@@ -247,13 +285,13 @@ void SingleHostClonalParasitePopulations::get_parasites_profiles(
   }
 
   // Some parasites are still present, continue the calculation
-  log10_total_relative_density = (*parasites_)[i]->get_log10_relative_density();
+  log10_total_relative_density = parasites_[i]->get_log10_relative_density();
   relative_parasite_density[i] = (log10_total_relative_density);
 
   // Scan the remainder of the parasites
   for (std::size_t j = i + 1; j < size; j++) {
     const auto log10_relative_density =
-        (*parasites_)[j]->get_log10_relative_density();
+        parasites_[j]->get_log10_relative_density();
 
     // Update or clear accordingly
     if (NumberHelpers::is_not_equal(
@@ -281,30 +319,78 @@ int SingleHostClonalParasitePopulations::latest_update_time() const {
 }
 
 int SingleHostClonalParasitePopulations::size() {
-  return static_cast<int>(parasites_->size());
+  return static_cast<int>(parasites_.size());
 }
 
 bool SingleHostClonalParasitePopulations::contain(
-    ClonalParasitePopulation* blood_parasite) {
-  for (auto &parasite : *parasites_) {
-    if (blood_parasite == parasite) { return true; }
+    ClonalParasitePopulation* blood_parasite, const ul_uid &uid) {
+  for (auto &parasite : parasites_) {
+    if (blood_parasite == parasite && parasite->get_uid() == uid) {
+      return true;
+    }
   }
 
   return false;
 }
 
 void SingleHostClonalParasitePopulations::change_all_parasite_update_function(
-    ParasiteDensityUpdateFunction* from,
-    ParasiteDensityUpdateFunction* to) const {
-  for (auto* parasite : *parasites_) {
+    ParasiteDensityUpdateFunction from,
+    ParasiteDensityUpdateFunction to) const {
+  for (auto* parasite : parasites_) {
     if (parasite->update_function() == from) {
       parasite->set_update_function(to);
     }
   }
 }
 
-void SingleHostClonalParasitePopulations::update() const {
-  for (auto* bp : *parasites_) { bp->update(); }
+void SingleHostClonalParasitePopulations::update() {
+  const auto size = parasites_.size();
+  const auto duration = Model::SCHEDULER->current_time() - latest_update_time();
+  if (size == 0 || duration == 0) { return; }
+
+  // The clearance rate depends only upon the host, so it is computed once
+  const auto log10_clearance_rate =
+      person_->immune_system()->get_log10_clearance_rate();
+  const auto asymptomatic =
+      Model::CONFIG->parasite_density_level().log_parasite_density_asymptomatic;
+
+  // Find the new density for each clone
+  InlineVector<double, INLINE_CLONES> density;
+  for (std::size_t ndx = 0; ndx < size; ndx++) {
+    const auto* parasite = parasites_[ndx];
+    const auto last = parasite->last_update_log10_parasite_density_;
+    switch (parasite->update_function_) {
+      case ParasiteDensityUpdateFunction::NONE:
+        density.push_back(last);
+        break;
+      case ParasiteDensityUpdateFunction::PROGRESS_TO_CLINICAL:
+        density.push_back(asymptomatic);
+        break;
+      default:
+        density.push_back(
+            last
+            + duration
+                  * (log10_clearance_rate
+                     + parasite->genotype_
+                           ->log10_daily_fitness_multiple_infection()));
+    }
+  }
+
+  // Apply the densities that changed
+  auto changed = false;
+  for (std::size_t ndx = 0; ndx < size; ndx++) {
+    auto* parasite = parasites_[ndx];
+    if (NumberHelpers::is_equal(parasite->last_update_log10_parasite_density_,
+                                density[ndx])) {
+      continue;
+    }
+    if (!changed) {
+      remove_all_infection_force();
+      changed = true;
+    }
+    parasite->last_update_log10_parasite_density_ = density[ndx];
+  }
+  if (changed) { add_all_infection_force(); }
 }
 
 void SingleHostClonalParasitePopulations::clear_cured_parasites() {
@@ -312,8 +398,8 @@ void SingleHostClonalParasitePopulations::clear_cured_parasites() {
   bool updated = false;
 
   // Clear all the cured parasites from the individual
-  for (int i = static_cast<int>(parasites_->size()) - 1; i >= 0; i--) {
-    if ((*parasites_)[i]->last_update_log10_parasite_density()
+  for (int i = static_cast<int>(parasites_.size()) - 1; i >= 0; i--) {
+    if (parasites_[i]->last_update_log10_parasite_density()
         <= Model::CONFIG->parasite_density_level().log_parasite_density_cured
                + 0.00001) {
       // Clear the infection force prior to removal
@@ -326,24 +412,59 @@ void SingleHostClonalParasitePopulations::clear_cured_parasites() {
   }
 
   // Update the infection force
-  if (updated) { add_all_infection_force(); }
+  if (updated) {
+    add_all_infection_force();
+    release_density_when_empty();
+  }
+}
+
+// Return the index of the clone that the next mutation for a drug occurs in,
+// given the mutation probability and the clone to start counting from. When the
+// probability is zero the mutation never occurs and no draw is made.
+static std::size_t next_mutation_trial(const double &p,
+                                       const std::size_t &from) {
+  if (p <= 0) { return std::numeric_limits<std::size_t>::max(); }
+  return from + Model::RANDOM->random_geometric(p) - 1;
 }
 
 void SingleHostClonalParasitePopulations::update_by_drugs(
     DrugsInBlood* drugs_in_blood) const {
-  for (auto &blood_parasite : *parasites_) {
+  // When aggregated, the (clone, drug) mutation trials are not rolled one by
+  // one, instead the gap to the next mutation for each drug is drawn from the
+  // geometric distribution since the probability is the same for each clone
+  const auto aggregate = Model::CONFIG->aggregate_mutation_sampling();
+  std::size_t next_mutation[DrugsInBlood::MAX_DRUG_TYPES];
+  if (aggregate) {
+    drugs_in_blood->for_each_drug([&next_mutation](Drug &drug) {
+      next_mutation[drug.drug_type()->id()] =
+          next_mutation_trial(drug.get_mutation_probability(), 0);
+    });
+  }
+
+  for (std::size_t ndx = 0; ndx < parasites_.size(); ndx++) {
+    auto* blood_parasite = parasites_[ndx];
+
     // Create a pointer to the current genotype
     auto* new_genotype = blood_parasite->genotype();
 
     // Percentage to remove is originally zero
     double percent_parasite_remove = 0.0;
 
-    for (auto &index : *drugs_in_blood->drugs()) {
-      const auto drug = index.second;
-
+    drugs_in_blood->for_each_drug([&](Drug &drug) {
       // Roll the dice to see if a mutation occurred
-      const auto p = Model::RANDOM->random_flat(0.0, 1.0);
-      if (p < drug->get_mutation_probability()) {
+      auto mutation = false;
+      if (aggregate) {
+        auto &next = next_mutation[drug.drug_type()->id()];
+        mutation = (next == ndx);
+        if (mutation) {
+          next = next_mutation_trial(drug.get_mutation_probability(), ndx + 1);
+        }
+      } else {
+        const auto p = Model::RANDOM->random_flat(0.0, 1.0);
+        mutation = p < drug.get_mutation_probability();
+      }
+
+      if (mutation) {
         // A mutation may occur, first we need to determine what it might be
         auto mutation_locus =
             static_cast<int>(Model::RANDOM->random_uniform_int(
@@ -359,8 +480,8 @@ void SingleHostClonalParasitePopulations::update_by_drugs(
         // mutation is favorable to the parasite. As a modeling simplification
         // we ignore scenarios where the EC50 is less than since the drug is
         // likely to clear the parasite.
-        if (mutation_genotype->get_EC50_power_n(drug->drug_type())
-            > new_genotype->get_EC50_power_n(drug->drug_type())) {
+        if (mutation_genotype->get_EC50_power_n(drug.drug_type())
+            > new_genotype->get_EC50_power_n(drug.drug_type())) {
           new_genotype = mutation_genotype;
         }
       }
@@ -373,11 +494,11 @@ void SingleHostClonalParasitePopulations::update_by_drugs(
       }
 
       // Update the percentage
-      const auto p_temp = drug->get_parasite_killing_rate(
+      const auto p_temp = drug.get_parasite_killing_rate(
           blood_parasite->genotype()->genotype_id());
       percent_parasite_remove = (percent_parasite_remove + p_temp)
                                 - (percent_parasite_remove * p_temp);
-    }
+    });
 
     // If the percent to remove is greater than zero, then perform the drug
     // action
@@ -388,7 +509,7 @@ void SingleHostClonalParasitePopulations::update_by_drugs(
 }
 
 bool SingleHostClonalParasitePopulations::has_detectable_parasite() const {
-  for (auto &parasite : *parasites_) {
+  for (auto &parasite : parasites_) {
     if (parasite->last_update_log10_parasite_density()
         >= Model::CONFIG->parasite_density_level()
                .log_parasite_density_detectable_pfpr) {
@@ -402,9 +523,9 @@ bool SingleHostClonalParasitePopulations::has_detectable_parasite() const {
 bool SingleHostClonalParasitePopulations::is_gametocytaemic() const {
   // This approach to the code is slightly faster than a foreach iterator
   // which is important since this gets called a lot!
-  auto size = parasites_->size();
+  auto size = parasites_.size();
   for (std::size_t ndx = 0; ndx < size; ndx++) {
-    if ((*parasites_)[ndx]->gametocyte_level() > 0) { return true; }
+    if (parasites_[ndx]->gametocyte_level() > 0) { return true; }
   }
   return false;
 }
@@ -8,16 +8,18 @@
 #ifndef SINGLE_HOST_CLONAL_PARASITE_POPULATIONS_H
 #define SINGLE_HOST_CLONAL_PARASITE_POPULATIONS_H
 
+#include <cstdint>
 #include <vector>
 
+#include "ClonalParasitePopulation.h"
+#include "Core/InlineVector.hxx"
 #include "Core/ObjectPool.h"
 #include "Core/PropertyMacro.h"
 #include "Core/TypeDef.h"
 
-class ClonalParasitePopulation;
 class DrugsInBlood;
 class DrugType;
-class ParasiteDensityUpdateFunction;
+class Genotype;
 class Person;
 
 class SingleHostClonalParasitePopulations {
@@ -27,16 +29,39 @@ class SingleHostClonalParasitePopulations {
 
   POINTER_PROPERTY(Person, person)
 
-  POINTER_PROPERTY(std::vector<ClonalParasitePopulation*>, parasites)
-
+  // Relative density by genotype, only allocated while the host is infected
   POINTER_PROPERTY(DoubleVector, relative_effective_parasite_density)
 
   // Total density of all parasites present in the host
   PROPERTY_REF(double, log10_total_relative_density);
 
+public:
+  // Number of clones that are stored inline, hosts with a higher multiplicity
+  // of infection will have the additional clones allocated on the heap
+  static constexpr int INLINE_CLONES = 4;
+
+  typedef InlineVector<ClonalParasitePopulation*, INLINE_CLONES> ParasiteList;
+
 private:
   int parasite_types = -1;
 
+  ParasiteList parasites_;
+
+  // Storage for the inline clones, the bits of clone_slots_ indicate which of
+  // the slots currently hold a constructed clone
+  alignas(ClonalParasitePopulation) unsigned char clone_storage_
+      [INLINE_CLONES * sizeof(ClonalParasitePopulation)];
+  std::uint8_t clone_slots_ = 0;
+
+  // Construct a new clone in a free inline slot, or on the heap if they are
+  // all in use
+  ClonalParasitePopulation* allocate_clone(Genotype* genotype);
+
+  void release_clone(ClonalParasitePopulation* clone);
+
+  // Release the relative density by genotype if there are no clones left
+  void release_density_when_empty();
+
   void remove(const std::size_t &index);
 
 public:
@@ -48,7 +73,11 @@ public:
 
   virtual int size();
 
-  virtual void add(ClonalParasitePopulation* blood_parasite);
+  ParasiteList* parasites() { return &parasites_; }
+
+  // Add a new clone of the given genotype to the host, the clone is owned by
+  // this object and is valid until it is cleared
+  virtual ClonalParasitePopulation* add(Genotype* genotype);
 
   virtual void add_all_infection_force();
 
@@ -58,13 +87,19 @@ public:
 
   [[nodiscard]] virtual int latest_update_time() const;
 
-  virtual bool contain(ClonalParasitePopulation* blood_parasite);
+  // Return true if the clone is still in the population. The inline storage
+  // of a cleared clone is reused by the next one, so the pointer held by an
+  // event is only trusted when the uid of the clone also matches.
+  virtual bool contain(ClonalParasitePopulation* blood_parasite,
+                       const ul_uid &uid);
 
   void change_all_parasite_update_function(
-      ParasiteDensityUpdateFunction* from,
-      ParasiteDensityUpdateFunction* to) const;
+      ParasiteDensityUpdateFunction from,
+      ParasiteDensityUpdateFunction to) const;
 
-  void update() const;
+  // Update the density of all the clones to the current time, the infection
+  // force for the host is only recalculated once if any of them changed
+  void update();
 
   void clear_cured_parasites();
 
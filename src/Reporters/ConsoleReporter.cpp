@@ -120,6 +120,7 @@ void ConsoleReporter::monthly_report() {
   if (Model::SCHEDULER->current_time() % Model::CONFIG->report_frequency()
       == 0) {
     //        Model::DATA_COLLECTOR->perform_population_statistic();
+    Model::MAIN_DATA_COLLECTOR->perform_immune_statistic();
 
     std::cout << Model::SCHEDULER->current_time() << "\t";
 
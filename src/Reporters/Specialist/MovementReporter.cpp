@@ -4,150 +4,168 @@
  * Implementation of the MovementReporter class.
  *
  * NOTE Since we assume this class will mostly be used for testing purposes,
- * there is an assumed dependency on DbReporter having already initialized the
- * database.
- *
- * NOTE This code could be significantly optimized; however, since it is only
- * used for the initial model validation it hasn't been tuned that much.
+ * the database is created for each job and is independent of the other
+ * reporters.
  */
 #include "MovementReporter.h"
 
+#include <algorithm>
+#include <filesystem>
+
 #include "Core/Config/Config.h"
-#include "Core/Random.h"
 #include "Model.h"
 #include "easylogging++.h"
 
-#define COUNT_LIMIT 100
-
-// Add a reported move to the update
+// Add a reported move to the buffer
 void MovementReporter::add_fine_move(int individual, int source,
                                      int destination) {
-  // Append the move
-  fine_update_query.append(fmt::format(INSERT_FINE_MOVE, replicate,
-                                       Model::SCHEDULER->current_time(),
-                                       individual, source, destination));
-
-  // Check to see if we should report
-  count++;
-  if (count >= COUNT_LIMIT) { fine_report(); }
+  fine_moves.push_back({Model::SCHEDULER->current_time(), individual, source,
+                        destination});
 }
 
-// Add a move between districts
+// Add a move between cells or districts
 void MovementReporter::add_coarse_move(int individual, int source,
                                        int destination) {
-  movement_counts[source][destination]++;
+  auto key = (static_cast<std::uint64_t>(source) << 32)
+             | static_cast<std::uint32_t>(destination);
+  movement_counts[key]++;
 }
 
-// Prepare and perform a bulk insert of the aggregated movements (can be
-// cell-to-cell or district-to-district)
-//
-// NOTE This is slowed down a lot by sending the query to the DB for each
-// source-destination. For district movements
-//      this isn't too bad, but for cellular it can be painfully slow.
+// Perform a bulk insert of the aggregated movements (can be cell-to-cell or
+// district-to-district), only the non-zero counts are stored so this scales
+// with the number of distinct pairs observed rather than the square of the
+// number of divisions.
 void MovementReporter::coarse_report() {
   // If we are at the zero time point, just return since we don't anticipate
   // anything to do
   auto timestep = Model::SCHEDULER->current_time();
   if (timestep == 0) { return; }
 
-  // Open the transaction
-  pqxx::work db(*conn);
-
-  // Send the inserts as we read the table, note that we assume that the
-  // division count is correct prepared with padding as needed if it is coming
-  // from one-index ArcGIS
-  std::string query;
-  for (auto source = 0; source < division_count; source++) {
-    for (auto destination = 0; destination < division_count; destination++) {
-      if (movement_counts[source][destination] == 0) { continue; }
-      query = fmt::format(INSERT_COARSE_MOVE, replicate, timestep,
-                          movement_counts[source][destination], source,
-                          destination);
-      movement_counts[source][destination] = 0;
-      db.exec(query);
-    }
-  }
-
-  if (query.empty()) {
+  if (movement_counts.empty()) {
     // Issue a warning if there were no movements since zeroed data is not
     // recorded
     LOG(WARNING) << "No movement between districts recorded.";
-    db.abort();
     return;
   }
 
-  // Commit the data
-  db.commit();
+  // Sort the pairs so the rows are inserted in a consistent order
+  std::vector<std::pair<std::uint64_t, int>> counts(movement_counts.begin(),
+                                                    movement_counts.end());
+  std::sort(counts.begin(), counts.end());
+  movement_counts.clear();
+
+  TransactionGuard tx(db.get());
+  auto* stmt = db->prepare(INSERT_COARSE_MOVE);
+  for (const auto &[key, count] : counts) {
+    sqlite3_bind_int(stmt, 1, timestep);
+    sqlite3_bind_int(stmt, 2, count);
+    sqlite3_bind_int(stmt, 3, static_cast<int>(key >> 32));
+    sqlite3_bind_int(stmt, 4, static_cast<int>(key & 0xFFFFFFFF));
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+      LOG(ERROR) << "Error executing INSERT statement";
+    }
+    sqlite3_reset(stmt);
+  }
+  sqlite3_finalize(stmt);
+  tx.commit();
 }
 
-// Open a connection to the database
+// Create the database for the job
 void MovementReporter::initialize(int job_number, const std::string &path) {
-  // Connect to the database
-  conn = new pqxx::connection(Model::CONFIG->connection_string());
-
-  // Since we are dependent upon DbReporter, the replicate should already be set
-  replicate = Model::MODEL->replicate();
-  if (replicate == 0) {
-    LOG(ERROR) << "Replicate value of zero, expected one or higher. Was "
-                  "DbReporter loaded?";
-    throw std::runtime_error("Invalid replicate value");
+  auto db_path = fmt::format("{}movement_{}.db", path, job_number);
+  if (std::filesystem::exists(db_path) && std::remove(db_path.c_str()) != 0) {
+    LOG(ERROR) << "Error deleting old movement database file.";
   }
+  db = std::make_unique<SQLiteDatabase>(db_path);
 
-  if (Model::MODEL->district_movement()) {
-    // Get the district count, prepare the memory. Note that we are assuming
-    // that the count is coming from ArcGis which will use one-based indexing.
-    // Therefore, we need some extra padding on the area to prevent errors.
-    // Since we are only inserting actual movement (i.e., district A to district
-    // B) cells with zero are not as big of a concern (baring any memory
-    // considerations).
-    division_count = SpatialData::get_instance().get_district_count();
-    if (division_count == -1) {
-      VLOG(1) << "District not loaded";
-      return;
-    }
+  const auto sampling_rate = Model::MODEL->movement_sampling_rate();
+  populate_db_schema(sampling_rate);
 
-    // Pad the count
-    division_count++;
-
-    VLOG(1) << "Real District Count: " << division_count - 1;
-    VLOG(1) << "Adjusted District Count: " << division_count;
-  } else {
-    // Assume we are tracking cells
-    division_count = static_cast<int>(Model::CONFIG->number_of_locations());
-    VLOG(1) << "Cell count: " << division_count;
-  }
+  // Inform the user that we are running
+  LOG(INFO) << fmt::format(
+      "MovementReporter loaded, writing to {} with a sampling rate of {}",
+      db_path, sampling_rate);
+}
 
-  // Prepare the memory, assume that padding is in place
-  movement_counts = new int*[division_count];
-  for (auto ndx = 0; ndx < division_count; ndx++) {
-    movement_counts[ndx] = new int[division_count];
-    for (auto ndy = 0; ndy < division_count; ndy++) {
-      movement_counts[ndx][ndy] = 0;
-    }
+// Create the tables, the sampling rate is recorded so that the counts can be
+// scaled to the full population
+void MovementReporter::populate_db_schema(double sampling_rate) {
+  const std::string create_settings = R""""(
+    CREATE TABLE IF NOT EXISTS movementsettings (
+        level TEXT NOT NULL,
+        samplingrate REAL NOT NULL
+    );
+  )"""";
+
+  const std::string create_movement = R""""(
+    CREATE TABLE IF NOT EXISTS movement (
+        timestep INTEGER NOT NULL,
+        individualid INTEGER NOT NULL,
+        source INTEGER NOT NULL,
+        destination INTEGER NOT NULL
+    );
+  )"""";
+
+  const std::string create_district_movement = R""""(
+    CREATE TABLE IF NOT EXISTS districtmovement (
+        timestep INTEGER NOT NULL,
+        count INTEGER NOT NULL,
+        source INTEGER NOT NULL,
+        destination INTEGER NOT NULL,
+        PRIMARY KEY (timestep, source, destination)
+    );
+  )"""";
+
+  // Individual movement takes precedence, see MovementValidation::add_move
+  std::string level = "D";
+  if (Model::MODEL->individual_movement()) {
+    level = "I";
+  } else if (Model::MODEL->cell_movement()) {
+    level = "C";
   }
 
-  // Inform the user that we are running
-  LOG(INFO) << fmt::format("MovementReporter loaded, using replicate {}",
-                           replicate);
+  TransactionGuard tx(db.get());
+  db->execute(create_settings);
+  db->execute(create_movement);
+  db->execute(create_district_movement);
+  db->execute(fmt::format(
+      "INSERT INTO movementsettings (level, samplingrate) VALUES ('{}', {});",
+      level, sampling_rate));
+  tx.commit();
 }
 
 // Call the relevant sub reports
 void MovementReporter::monthly_report() {
-  if (movement_counts != nullptr) { coarse_report(); }
-  if (count > 0) { fine_report(); }
+  if (Model::MODEL->individual_movement()) {
+    if (!fine_moves.empty()) { fine_report(); }
+    return;
+  }
+  coarse_report();
 }
 
 // Insert the buffered moves into the database
 void MovementReporter::fine_report() {
-  // Insert the fine movement data
-  pqxx::work db(*conn);
-  db.exec(fine_update_query);
-  db.commit();
-
-  // Reset the query and counter
-  fine_update_query = "";
-  count = 0;
+  TransactionGuard tx(db.get());
+  auto* stmt = db->prepare(INSERT_FINE_MOVE);
+  for (const auto &move : fine_moves) {
+    sqlite3_bind_int(stmt, 1, move.timestep);
+    sqlite3_bind_int(stmt, 2, move.individual);
+    sqlite3_bind_int(stmt, 3, move.source);
+    sqlite3_bind_int(stmt, 4, move.destination);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+      LOG(ERROR) << "Error executing INSERT statement";
+    }
+    sqlite3_reset(stmt);
+  }
+  sqlite3_finalize(stmt);
+  tx.commit();
+
+  // Reset the buffer
+  fine_moves.clear();
 }
 
-// Close the connection
-void MovementReporter::after_run() { conn->close(); }
+// Write anything recorded since the last monthly report
+void MovementReporter::after_run() {
+  if (!movement_counts.empty()) { coarse_report(); }
+  if (!fine_moves.empty()) { fine_report(); }
+}
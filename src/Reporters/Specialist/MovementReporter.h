@@ -1,38 +1,50 @@
 /*
  * MovementReporter.h
  *
- * Define the MovementReporter class which is used to insert movement
- * information into the database. When running for large populations over long
- * periods of time, this will be a bit quicker since updates are buffered until
- * the end of the time step.
+ * Define the MovementReporter class which is used to record movement
+ * information to a local SQLite database. Moves between cells or districts are
+ * aggregated in memory as sparse origin-destination counts, and individual
+ * moves are buffered, both are then written with bulk prepared statement
+ * inserts at the end of each month.
  */
 #ifndef MOVEMENTREPORTER_H
 #define MOVEMENTREPORTER_H
 
-#include <pqxx/pqxx>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
+#include "Helpers/SQLiteDatabase.h"
 #include "Reporters/Reporter.h"
 
 class MovementReporter : public Reporter {
 private:
   const std::string INSERT_FINE_MOVE =
-      "INSERT INTO sim.Movement (ReplicateId, Timestep, IndividualId, Source, "
-      "Destination) "
-      "VALUES ({}, {}, {}, {}, {});";
+      "INSERT INTO movement (timestep, individualid, source, destination) "
+      "VALUES (?, ?, ?, ?);";
 
   const std::string INSERT_COARSE_MOVE =
-      "INSERT INTO sim.DistrictMovement (ReplicateId, Timestep, Count, Source, "
-      "Destination) "
-      "VALUES ({}, {}, {}, {}, {});";
+      "INSERT INTO districtmovement (timestep, count, source, destination) "
+      "VALUES (?, ?, ?, ?);";
 
-  int count = 0;
-  int replicate = 0;
-  pqxx::connection* conn = nullptr;
-  std::string fine_update_query;
+  struct FineMove {
+    int timestep;
+    int individual;
+    int source;
+    int destination;
+  };
 
-  int division_count = 0;
-  int** movement_counts = nullptr;
+  std::unique_ptr<SQLiteDatabase> db;
+
+  // Individual moves since the last report
+  std::vector<FineMove> fine_moves;
+
+  // Count of moves since the last report, keyed by the source in the high
+  // bits and the destination in the low bits
+  std::unordered_map<std::uint64_t, int> movement_counts;
+
+  void populate_db_schema(double sampling_rate);
 
 public:
   MovementReporter() = default;
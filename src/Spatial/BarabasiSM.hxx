@@ -35,17 +35,17 @@ public:
 
   [[nodiscard]] DoubleVector get_v_relative_out_movement_to_destination(
       const int &from_location, const int &number_of_locations,
-      const DoubleVector &relative_distance_vector,
+      const DistanceMatrix &distances,
       const IntVector &v_number_of_residents_by_location) const override {
     DoubleVector v_relative_number_of_circulation_by_location(
         number_of_locations, 0);
     for (int target_location = 0; target_location < number_of_locations;
          target_location++) {
-      if (NumberHelpers::is_zero(relative_distance_vector[target_location])) {
+      auto r_g = distances(from_location, target_location);
+      if (NumberHelpers::is_zero(r_g)) {
         v_relative_number_of_circulation_by_location[target_location] = 0;
       } else {
         // P(r_g) = (r_g + r_g^0)^{-\beta_r}exp(\frac{-r_g}{\kappa})
-        auto r_g = relative_distance_vector[target_location];
         v_relative_number_of_circulation_by_location[target_location] =
             pow((r_g + r_g_0_), -beta_r_) * exp(-r_g / kappa_);
       }
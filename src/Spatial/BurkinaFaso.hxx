@@ -41,14 +41,14 @@ private:
     kernel = new double*[locations];
 
     // Get the distance matrix
-    auto distance = Model::CONFIG->spatial_distance_matrix();
+    const auto &distance = Model::CONFIG->spatial_distance_matrix();
 
     // Iterate through all the locations and calculate the kernel
     for (auto source = 0; source < locations; source++) {
       kernel[source] = new double[locations];
       for (auto destination = 0; destination < locations; destination++) {
         kernel[source][destination] =
-            std::pow(1 + (distance[source][destination] / rho_), (-alpha_));
+            std::pow(1 + (distance(source, destination) / rho_), (-alpha_));
       }
     }
   }
@@ -84,7 +84,7 @@ public:
 
   [[nodiscard]] DoubleVector get_v_relative_out_movement_to_destination(
       const int &from_location, const int &number_of_locations,
-      const DoubleVector &relative_distance_vector,
+      const DistanceMatrix &distances,
       const IntVector &v_number_of_residents_by_location) const override {
     // Dependent objects should have been created already, so throw an exception
     // if they are not
@@ -106,7 +106,7 @@ public:
     for (auto destination = 0; destination < number_of_locations;
          destination++) {
       // Continue if there is nothing to do
-      if (NumberHelpers::is_zero(relative_distance_vector[destination])) {
+      if (NumberHelpers::is_zero(distances(from_location, destination))) {
         continue;
       }
 
@@ -0,0 +1,129 @@
+/*
+ * DistanceMatrix.cpp
+ *
+ * Implementation of the DistanceMatrix class.
+ */
+#define _USE_MATH_DEFINES
+
+#include "DistanceMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Spatial {
+DistanceMatrix DistanceMatrix::from_raster(
+    const std::vector<Location> &locations, float cell_size) {
+  DistanceMatrix matrix;
+  matrix.raster_ = true;
+  matrix.cell_size_ = cell_size;
+  for (const auto &location : locations) {
+    matrix.latitude_.push_back(location.coordinate->latitude);
+    matrix.longitude_.push_back(location.coordinate->longitude);
+  }
+  matrix.prepare();
+  return matrix;
+}
+
+DistanceMatrix DistanceMatrix::from_coordinates(
+    const std::vector<Location> &locations) {
+  DistanceMatrix matrix;
+  for (const auto &location : locations) {
+    matrix.latitude_.push_back(location.coordinate->latitude);
+    matrix.longitude_.push_back(location.coordinate->longitude);
+    matrix.cos_latitude_.push_back(
+        std::cos(location.coordinate->latitude * (M_PI / 180)));
+  }
+  matrix.prepare();
+  return matrix;
+}
+
+void DistanceMatrix::prepare() {
+  by_latitude_.resize(size());
+  for (std::size_t ndx = 0; ndx < size(); ndx++) {
+    by_latitude_[ndx] = static_cast<int>(ndx);
+  }
+  std::stable_sort(by_latitude_.begin(), by_latitude_.end(),
+                   [this](int lhs, int rhs) {
+                     return latitude_[lhs] < latitude_[rhs];
+                   });
+  sorted_latitude_.resize(size());
+  for (std::size_t ndx = 0; ndx < size(); ndx++) {
+    sorted_latitude_[ndx] = latitude_[by_latitude_[ndx]];
+  }
+
+  if (size() > DENSE_LIMIT) { return; }
+  dense_.resize(size());
+  for (std::size_t from = 0; from < size(); from++) {
+    dense_[from].resize(size());
+    for (std::size_t to = 0; to < size(); to++) {
+      dense_[from][to] = calculate(from, to);
+    }
+  }
+}
+
+double DistanceMatrix::calculate(std::size_t from, std::size_t to) const {
+  if (raster_) {
+    const double x = cell_size_ * (latitude_[from] - latitude_[to]);
+    const double y = cell_size_ * (longitude_[from] - longitude_[to]);
+    return std::sqrt(x * x + y * y);
+  }
+
+  // Haversine, this matches Coordinate::calculate_distance_in_km
+  const double p = M_PI / 180;
+  const double d_lat = p * (latitude_[from] - latitude_[to]);
+  const double d_lon = p * (longitude_[from] - longitude_[to]);
+  const double a = sin(d_lat / 2) * sin(d_lat / 2)
+                   + cos_latitude_[from] * cos_latitude_[to] * sin(d_lon / 2)
+                         * sin(d_lon / 2);
+  return 6371 * (2 * atan2(sqrt(a), sqrt(1 - a)));
+}
+
+double DistanceMatrix::distance_between(double latitude_a,
+                                        double longitude_a, double latitude_b,
+                                        double longitude_b) const {
+  if (raster_) {
+    return cell_size_
+           * std::sqrt(std::pow(latitude_a - latitude_b, 2)
+                       + std::pow(longitude_a - longitude_b, 2));
+  }
+  const double p = M_PI / 180;
+  const double d_lat = p * (latitude_a - latitude_b);
+  const double d_lon = p * (longitude_a - longitude_b);
+  const double a = sin(d_lat / 2) * sin(d_lat / 2)
+                   + cos(latitude_a * p) * cos(latitude_b * p) * sin(d_lon / 2)
+                         * sin(d_lon / 2);
+  return 6371 * (2 * atan2(sqrt(a), sqrt(1 - a)));
+}
+
+void DistanceMatrix::get_row(std::size_t from, DoubleVector &row) const {
+  if (!dense_.empty()) {
+    row = dense_[from];
+    return;
+  }
+  row.resize(size());
+  for (std::size_t to = 0; to < size(); to++) { row[to] = calculate(from, to); }
+}
+
+void DistanceMatrix::get_within(std::size_t from, double radius,
+                                std::vector<int> &destinations) const {
+  // The distance is at least the difference in latitude, so the band is given
+  // by the radius in the units of the latitude, padded for rounding
+  const auto band = (raster_ ? radius / cell_size_
+                             : radius / (6371 * (M_PI / 180)))
+                        * (1 + 1e-6)
+                    + 1e-6;
+  const auto first = std::lower_bound(sorted_latitude_.begin(),
+                                      sorted_latitude_.end(),
+                                      latitude_[from] - band);
+  const auto last = std::upper_bound(first, sorted_latitude_.end(),
+                                     latitude_[from] + band);
+
+  destinations.clear();
+  for (auto ndx = first - sorted_latitude_.begin();
+       ndx < last - sorted_latitude_.begin(); ndx++) {
+    const auto to = by_latitude_[ndx];
+    if ((*this)(from, to) <= radius) { destinations.push_back(to); }
+  }
+  std::sort(destinations.begin(), destinations.end());
+}
+}  // namespace Spatial
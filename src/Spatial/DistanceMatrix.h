@@ -0,0 +1,88 @@
+/*
+ * DistanceMatrix.h
+ *
+ * Define the distances between the locations in the model. Since a dense
+ * matrix grows with the square of the number of locations (i.e., about 80 GB
+ * for 100k raster cells), the distances are computed on demand from the
+ * coordinates of the locations unless the number of locations is small enough
+ * that the full matrix can be stored.
+ */
+#ifndef SPATIAL_DISTANCEMATRIX_H
+#define SPATIAL_DISTANCEMATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Core/TypeDef.h"
+#include "Location.h"
+
+namespace Spatial {
+class DistanceMatrix {
+public:
+  // Locations at or below this count have the full matrix stored (128 MB)
+  static constexpr std::size_t DENSE_LIMIT = 4096;
+
+private:
+  // Euclidean distances between raster cells, or Haversine distances in km
+  // between coordinates
+  bool raster_{false};
+  float cell_size_{0};
+
+  std::vector<float> latitude_;
+  std::vector<float> longitude_;
+
+  // Cosine of the latitude, used by the Haversine formula
+  std::vector<double> cos_latitude_;
+
+  // Locations ordered by latitude, used to find the locations within a radius
+  std::vector<int> by_latitude_;
+  std::vector<float> sorted_latitude_;
+
+  // Stored matrix, empty if the distances are computed on demand
+  DoubleVector2 dense_;
+
+  [[nodiscard]] double calculate(std::size_t from, std::size_t to) const;
+
+  void prepare();
+
+public:
+  DistanceMatrix() = default;
+
+  // Distances between the cells of a raster, the latitude and longitude of the
+  // locations are the row and column of the cell
+  static DistanceMatrix from_raster(const std::vector<Location> &locations,
+                                    float cell_size);
+
+  // Distances in km between the coordinates of the locations
+  static DistanceMatrix from_coordinates(
+      const std::vector<Location> &locations);
+
+  [[nodiscard]] std::size_t size() const { return latitude_.size(); }
+
+  // Return true if the full matrix is stored
+  [[nodiscard]] bool is_dense() const { return !dense_.empty(); }
+
+  // Return the distance between the two locations
+  [[nodiscard]] double operator()(std::size_t from, std::size_t to) const {
+    if (!dense_.empty()) { return dense_[from][to]; }
+    return calculate(from, to);
+  }
+
+  // Return the distance between two points given in the same coordinates as
+  // the locations (e.g., the centroid of a group of locations)
+  [[nodiscard]] double distance_between(double latitude_a, double longitude_a,
+                                        double latitude_b,
+                                        double longitude_b) const;
+
+  // Fill the row with the distances from the location to all locations
+  void get_row(std::size_t from, DoubleVector &row) const;
+
+  // Fill the destinations with the locations whose distance from the location
+  // is at most the radius, in order of the location id. Only the locations in
+  // the band of latitude that could be within the radius are checked.
+  void get_within(std::size_t from, double radius,
+                  std::vector<int> &destinations) const;
+};
+}  // namespace Spatial
+
+#endif
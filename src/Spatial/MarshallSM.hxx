@@ -8,10 +8,13 @@
 #ifndef MARSHALLSM_HXX
 #define MARSHALLSM_HXX
 
+#include <vector>
+
 #include "Core/Config/Config.h"
 #include "Helpers/NumberHelpers.hxx"
 #include "Model.h"
 #include "SpatialModel.hxx"
+#include "easylogging++.h"
 #include "yaml-cpp/yaml.h"
 
 namespace Spatial {
@@ -22,6 +25,10 @@ class MarshallSM : public SpatialModel {
   VIRTUAL_PROPERTY_REF(double, alpha)
   VIRTUAL_PROPERTY_REF(double, rho)
 
+  // Kernel values below this fraction of the largest value (i.e., the source
+  // itself) are dropped, zero to use the dense kernel
+  VIRTUAL_PROPERTY_REF(double, kernel_threshold)
+
 private:
   // Hold on to the total number of locations, so we can free the kernel
   unsigned long locations = 0;
@@ -29,46 +36,88 @@ private:
   // Pointer to the kernel object since it only needs to be computed once
   double** kernel = nullptr;
 
+  // Sparse kernel in compressed sparse row form, the entries for the source
+  // are in [offsets[source], offsets[source + 1])
+  std::vector<std::size_t> sparse_offsets;
+  std::vector<int> sparse_destinations;
+  std::vector<float> sparse_values;
+
   // Precompute the kernel function for the movement model
   void prepare_kernel() {
     // Allocate the memory
     kernel = new double*[locations];
 
     // Get the distance matrix
-    auto distance = Model::CONFIG->spatial_distance_matrix();
+    const auto &distance = Model::CONFIG->spatial_distance_matrix();
 
     // Iterate through all  the locations and calculate the kernel
     for (auto source = 0; source < locations; source++) {
       kernel[source] = new double[locations];
       for (auto destination = 0; destination < locations; destination++) {
         kernel[source][destination] =
-            std::pow(1 + (distance[source][destination] / rho_), (-alpha_));
+            std::pow(1 + (distance(source, destination) / rho_), (-alpha_));
       }
     }
   }
 
+  // Precompute the sparse kernel, since the kernel is one at the source and
+  // decreases with distance, only the destinations within the distance at
+  // which it falls to the threshold need to be evaluated
+  void prepare_sparse_kernel() {
+    const auto &distance = Model::CONFIG->spatial_distance_matrix();
+    const auto radius = rho_ * (std::pow(kernel_threshold_, -1 / alpha_) - 1);
+
+    std::vector<int> destinations;
+    sparse_offsets.assign(1, 0);
+    for (std::size_t source = 0; source < locations; source++) {
+      distance.get_within(source, radius, destinations);
+      for (auto destination : destinations) {
+        const auto value =
+            std::pow(1 + (distance(source, destination) / rho_), (-alpha_));
+        if (value < kernel_threshold_) { continue; }
+        sparse_destinations.push_back(destination);
+        sparse_values.push_back(static_cast<float>(value));
+      }
+      sparse_offsets.push_back(sparse_destinations.size());
+    }
+
+    VLOG(1) << fmt::format("Sparse kernel has {} of {} entries",
+                           sparse_values.size(), locations * locations);
+  }
+
 public:
   explicit MarshallSM(const YAML::Node &node) {
     tau_ = node["tau"].as<double>();
     alpha_ = node["alpha"].as<double>();
     rho_ = std::pow(10, node["log_rho"].as<double>());
+    kernel_threshold_ = node["kernel_threshold"]
+                            ? node["kernel_threshold"].as<double>()
+                            : 0.0;
+    if (kernel_threshold_ < 0 || kernel_threshold_ >= 1) {
+      throw std::invalid_argument(
+          "Marshall kernel_threshold must be in the range [0, 1)");
+    }
   }
 
   ~MarshallSM() override {
     if (kernel != nullptr) {
-      for (auto ndx = 0; ndx < locations; ndx++) { delete kernel[ndx]; }
-      delete kernel;
+      for (auto ndx = 0; ndx < locations; ndx++) { delete[] kernel[ndx]; }
+      delete[] kernel;
     }
   }
 
   void prepare() override {
     locations = Model::CONFIG->number_of_locations();
-    prepare_kernel();
+    if (kernel_threshold_ > 0) {
+      prepare_sparse_kernel();
+    } else {
+      prepare_kernel();
+    }
   }
 
   [[nodiscard]] DoubleVector get_v_relative_out_movement_to_destination(
       const int &from_location, const int &number_of_locations,
-      const DoubleVector &relative_distance_vector,
+      const DistanceMatrix &distances,
       const IntVector &v_number_of_residents_by_location) const override {
     // Note the population size
     auto population = v_number_of_residents_by_location[from_location];
@@ -76,10 +125,23 @@ public:
     // Prepare the vector for results
     std::vector<double> results(number_of_locations, 0.0);
 
+    // Only the retained entries of the sparse kernel need to be visited
+    if (kernel == nullptr) {
+      for (auto ndx = sparse_offsets[from_location];
+           ndx < sparse_offsets[from_location + 1]; ndx++) {
+        const auto destination = sparse_destinations[ndx];
+        if (NumberHelpers::is_zero(distances(from_location, destination))) {
+          continue;
+        }
+        results[destination] = std::pow(population, tau_) * sparse_values[ndx];
+      }
+      return results;
+    }
+
     for (auto destination = 0; destination < number_of_locations;
          destination++) {
       // Continue if there is nothing to do
-      if (NumberHelpers::is_zero(relative_distance_vector[destination])) {
+      if (NumberHelpers::is_zero(distances(from_location, destination))) {
         continue;
       }
 
@@ -0,0 +1,144 @@
+/*
+ * MovementDistribution.hxx
+ *
+ * This pseudo-library defines the distribution of the destinations for the
+ * individuals leaving a location. Only the destinations with a non-zero weight
+ * are stored, along with their cumulative weights, so that the destination of
+ * each traveller can be drawn with a binary search. Drawing k travellers is
+ * then O(k log L) rather than the O(L) of a multinomial over all of the
+ * locations, and gives the same distribution of counts.
+ */
+#ifndef SPATIAL_MOVEMENTDISTRIBUTION_HXX
+#define SPATIAL_MOVEMENTDISTRIBUTION_HXX
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Spatial {
+class MovementDistribution {
+private:
+  // Largest double below one, used to keep rescaled uniforms in [0, 1)
+  static constexpr double UNIFORM_LIMIT = 1.0 - 1.0 / 9007199254740992.0;
+
+  bool prepared_{false};
+  std::vector<int> destinations_;
+  std::vector<double> cumulative_;
+
+  // Return the index of the first destination whose cumulative weight is
+  // greater than the target
+  [[nodiscard]] std::size_t find(double target) const {
+    auto index = static_cast<std::size_t>(
+        std::upper_bound(cumulative_.begin(), cumulative_.end(), target)
+        - cumulative_.begin());
+    return index == cumulative_.size() ? index - 1 : index;
+  }
+
+  [[nodiscard]] double previous(std::size_t index) const {
+    return index == 0 ? 0.0 : cumulative_[index - 1];
+  }
+
+  // Return the smallest weight that is kept when the smallest weights, which
+  // together carry no more than the truncated fraction of the total, are
+  // dropped
+  [[nodiscard]] static double truncation_threshold(
+      const std::vector<double> &weights, double truncated) {
+    std::vector<double> sorted;
+    auto total = 0.0;
+    for (auto weight : weights) {
+      if (!(weight > 0)) { continue; }
+      sorted.push_back(weight);
+      total += weight;
+    }
+    if (sorted.empty()) { return 0.0; }
+    std::sort(sorted.begin(), sorted.end());
+
+    auto dropped = 0.0;
+    for (auto weight : sorted) {
+      if (dropped + weight > truncated * total) { return weight; }
+      dropped += weight;
+    }
+    return sorted.back();
+  }
+
+public:
+  MovementDistribution() = default;
+
+  // Set the distribution from the relative weights of all of the locations.
+  // When truncated is greater than zero the smallest weights, which together
+  // carry no more than that fraction of the total, are dropped; so the total
+  // variation distance from the full distribution is at most truncated.
+  void assign(const std::vector<double> &weights, double truncated = 0.0) {
+    const auto threshold =
+        (truncated > 0) ? truncation_threshold(weights, truncated) : 0.0;
+    destinations_.clear();
+    cumulative_.clear();
+    auto sum = 0.0;
+    for (std::size_t ndx = 0; ndx < weights.size(); ndx++) {
+      if (!(weights[ndx] > 0) || weights[ndx] < threshold) { continue; }
+      sum += weights[ndx];
+      destinations_.push_back(static_cast<int>(ndx));
+      cumulative_.push_back(sum);
+    }
+    prepared_ = true;
+  }
+
+  // Return true if the distribution has been assigned
+  [[nodiscard]] bool prepared() const { return prepared_; }
+
+  // Return true if there are no destinations with a non-zero weight
+  [[nodiscard]] bool empty() const { return destinations_.empty(); }
+
+  [[nodiscard]] const std::vector<int> &destinations() const {
+    return destinations_;
+  }
+
+  // Return the probability of moving to the destination at the index
+  [[nodiscard]] double probability(std::size_t index) const {
+    return (cumulative_[index] - previous(index)) / cumulative_.back();
+  }
+
+  // Return the destination for the uniform random number in [0, 1)
+  [[nodiscard]] int sample(double uniform) const {
+    return destinations_[sample_index(uniform)];
+  }
+
+  // Return the index of the destination for the uniform random number in
+  // [0, 1). The uniform is rescaled to [0, 1) within the interval of the
+  // destination, so that it may be reused for a further draw.
+  std::size_t sample_index(double &uniform) const {
+    const auto target = uniform * cumulative_.back();
+    const auto index = find(target);
+    const auto start = previous(index);
+    uniform = std::min((target - start) / (cumulative_[index] - start),
+                       UNIFORM_LIMIT);
+    return index;
+  }
+
+  // Return the destination for the uniform random number in [0, 1) with the
+  // excluded destination removed from the distribution, or -1 if there are no
+  // other destinations
+  [[nodiscard]] int sample_excluding(double uniform, int excluded) const {
+    const auto position =
+        std::lower_bound(destinations_.begin(), destinations_.end(), excluded);
+    if (position == destinations_.end() || *position != excluded) {
+      return sample(uniform);
+    }
+    if (destinations_.size() == 1) { return -1; }
+
+    // Draw over the total without the excluded weight, then skip over it
+    const auto index =
+        static_cast<std::size_t>(position - destinations_.begin());
+    const auto weight = cumulative_[index] - previous(index);
+    auto target = uniform * (cumulative_.back() - weight);
+    if (target >= previous(index)) { target += weight; }
+    auto selected = find(target);
+
+    // Guard against rounding at the edge of the excluded interval
+    if (selected == index) { selected = index == 0 ? 1 : index - 1; }
+    return destinations_[selected];
+  }
+};
+}  // namespace Spatial
+
+#endif
@@ -7,14 +7,34 @@
 #ifndef SPATIAL_SPATIALMODEL_H
 #define SPATIAL_SPATIALMODEL_H
 
+#include <atomic>
+
+#include "Core/Config/Config.h"
 #include "Core/PropertyMacro.h"
 #include "Core/TypeDef.h"
+#include "DistanceMatrix.h"
 #include "Model.h"
+#include "MovementDistribution.hxx"
 
 namespace Spatial {
 class SpatialModel {
   DELETE_COPY_AND_MOVE(SpatialModel)
 
+private:
+  // Residents by location that the cached distributions were computed for
+  IntVector cached_residents_;
+
+  // Movement distribution for each source location, computed on first use
+  std::vector<MovementDistribution> cached_distributions_;
+
+  // Number of destinations held by the cached distributions
+  std::atomic<std::size_t> cached_entries_{0};
+
+  // Identifies the residents that the distributions are computed for, this is
+  // unique across the models so a distribution is never reused by mistake
+  std::size_t generation_{0};
+  inline static std::atomic<std::size_t> last_generation_{0};
+
 protected:
   // Prepare the travel raster for the movement model
   static double* prepare_surface(const SpatialData::SpatialFileType type) {
@@ -41,7 +61,34 @@ protected:
     return travel;
   }
 
+  // Residents by location noted by the last update_residents_by_location
+  [[nodiscard]] const IntVector &residents_by_location() const {
+    return cached_residents_;
+  }
+
+  // Compute the distribution of movement out of the source location
+  [[nodiscard]] DoubleVector compute_distribution(int from_location) const {
+    return get_v_relative_out_movement_to_destination(
+        from_location, static_cast<int>(cached_residents_.size()),
+        Model::CONFIG->spatial_distance_matrix(), cached_residents_);
+  }
+
+  // Allow the spatial model to rebuild anything that depends upon the
+  // residents by location when they change
+  virtual void residents_changed() {}
+
 public:
+  // Above this number of locations the cached distributions are truncated,
+  // the smallest weights that together carry no more than TRUNCATED_MASS of
+  // the probability are dropped from each source
+  static constexpr std::size_t CACHE_ALL_LIMIT = 4096;
+  static constexpr double TRUNCATED_MASS = 1e-3;
+
+  // Upper bound on the destinations held by the cached distributions (about
+  // 1.6 GB), once it is reached the distributions of the remaining sources
+  // are computed each time they are used
+  static constexpr std::size_t CACHE_ENTRY_LIMIT = std::size_t{1} << 27;
+
   SpatialModel() = default;
 
   virtual ~SpatialModel() = default;
@@ -51,9 +98,61 @@ public:
 
   [[nodiscard]] virtual DoubleVector get_v_relative_out_movement_to_destination(
       const int &from_location, const int &number_of_locations,
-      const DoubleVector &relative_distance_vector,
+      const DistanceMatrix &distances,
       const IntVector &v_number_of_residents_by_location) const = 0;
-  ;
+
+  // Note the residents by location that are used by the movement model, the
+  // cached distributions are discarded only if the residents have changed
+  // since the last call.
+  void update_residents_by_location(const IntVector &residents) {
+    if (residents == cached_residents_) { return; }
+    cached_residents_ = residents;
+    generation_ = ++last_generation_;
+    cached_distributions_.clear();
+    cached_distributions_.resize(residents.size());
+    cached_entries_ = 0;
+    residents_changed();
+  }
+
+  // Return the distribution of movement out of the source location for the
+  // residents noted by update_residents_by_location. The distribution is
+  // computed the first time that it is requested and reused until the
+  // residents change, for large numbers of locations it is truncated (see
+  // TRUNCATED_MASS) to keep the cache compact. Once the cache holds
+  // CACHE_ENTRY_LIMIT destinations only the last distribution computed by
+  // each thread is kept.
+  const MovementDistribution &get_movement_distribution(
+      const int &from_location) {
+    auto &distribution = cached_distributions_[from_location];
+    if (distribution.prepared()) { return distribution; }
+
+    const auto truncated =
+        (cached_residents_.size() > CACHE_ALL_LIMIT) ? TRUNCATED_MASS : 0.0;
+    if (cached_entries_ < CACHE_ENTRY_LIMIT) {
+      distribution.assign(compute_distribution(from_location), truncated);
+      cached_entries_ += distribution.destinations().size();
+      return distribution;
+    }
+
+    thread_local std::size_t last_generation = 0;
+    thread_local int last_location = -1;
+    thread_local MovementDistribution last_distribution;
+    if (last_generation != generation_ || last_location != from_location) {
+      last_distribution.assign(compute_distribution(from_location), truncated);
+      last_generation = generation_;
+      last_location = from_location;
+    }
+    return last_distribution;
+  }
+
+  // Return the destination of a traveller leaving the source location for the
+  // uniform random number in [0, 1), or -1 if there is no destination. This
+  // is called in parallel for different source locations.
+  virtual int sample_destination(const int &from_location, double uniform) {
+    const auto &distribution = get_movement_distribution(from_location);
+    if (distribution.empty()) { return -1; }
+    return distribution.sample(uniform);
+  }
 };
 }  // namespace Spatial
 
@@ -11,6 +11,7 @@
 #include "Core/PropertyMacro.h"
 #include "MarshallSM.hxx"
 #include "SpatialModel.hxx"
+#include "WesolowskiDistrictSM.hxx"
 #include "WesolowskiSM.hxx"
 #include "WesolowskiSurfaceSM.hxx"
 #include "yaml-cpp/yaml.h"
@@ -28,6 +29,7 @@ public:
     if (name == "Marshall") { return new MarshallSM(node); }
     if (name == "Wesolowski") { return new WesolowskiSM(node); }
     if (name == "WesolowskiSurface") { return new WesolowskiSurfaceSM(node); }
+    if (name == "WesolowskiDistrict") { return new WesolowskiDistrictSM(node); }
 
     // Potentially deprecated movement models
     if (name == "Barabasi") {
@@ -0,0 +1,333 @@
+/*
+ * WesolowskiDistrictSM.hxx
+ *
+ * Two-stage version of the WesolowskiSurfaceSM movement model for large
+ * rasters. The destination district is drawn from the gravity model evaluated
+ * between the districts (D x D), then the destination cell is drawn from the
+ * cells of that district weighted by their population and travel surface.
+ * Preparing the model when the residents change is O(D^2 + L) rather than the
+ * O(L^2) of the cell to cell models.
+ *
+ * The distance between two districts is the distance between their population
+ * weighted centroids, and within a district it is the root mean square
+ * distance between two residents of the district. Since this is an
+ * approximation of the flat model, the calibration_sources setting allows the
+ * two to be compared when the model is first prepared.
+ */
+#ifndef SPATIAL_WESOLOWSKIDISTRICTSM_HXX
+#define SPATIAL_WESOLOWSKIDISTRICTSM_HXX
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "Core/PropertyMacro.h"
+#include "GIS/SpatialData.h"
+#include "Helpers/NumberHelpers.hxx"
+#include "SpatialModel.hxx"
+#include "WesolowskiSurfaceSM.hxx"
+#include "easylogging++.h"
+#include "yaml-cpp/yaml.h"
+
+namespace Spatial {
+class WesolowskiDistrictSM : public SpatialModel {
+  DELETE_COPY_AND_MOVE(WesolowskiDistrictSM)
+
+  VIRTUAL_PROPERTY_REF(double, kappa)
+  VIRTUAL_PROPERTY_REF(double, alpha)
+  VIRTUAL_PROPERTY_REF(double, beta)
+  VIRTUAL_PROPERTY_REF(double, gamma)
+
+  // Number of source cells to compare against the flat model, zero to disable
+  VIRTUAL_PROPERTY_REF(int, calibration_sources)
+
+public:
+  // Mean total variation distance between the two-stage and flat models
+  struct Calibration {
+    double districts;
+    double cells;
+  };
+
+private:
+  // Distributions of the two stages for a given set of residents
+  struct Tables {
+    // Destination district for each source district
+    std::vector<MovementDistribution> districts;
+
+    // Destination cell for each district, the destinations are the positions
+    // of the cells in district_cells
+    std::vector<MovementDistribution> cells;
+  };
+
+  YAML::Node node_;
+
+  // Travel surface, coordinates, and distances of the cells, set when the
+  // prepare method is called
+  DoubleVector travel_;
+  DoubleVector latitude_;
+  DoubleVector longitude_;
+  const DistanceMatrix* distances_ = nullptr;
+
+  // District of each cell, the cells of each district in order of the id, and
+  // the position of each cell in its district
+  IntVector cell_district_;
+  std::vector<IntVector> district_cells_;
+  IntVector cell_position_;
+
+  Tables tables_;
+  bool calibrated_{false};
+
+  [[nodiscard]] Tables build_tables(const IntVector &residents) const {
+    const auto &distances = *distances_;
+    const auto district_count = district_cells_.size();
+
+    // Population, centroid, mean travel, and spread of each district
+    DoubleVector population(district_count, 0), latitude(district_count, 0),
+        longitude(district_count, 0), mean_travel(district_count, 0),
+        spread(district_count, 0);
+    Tables tables;
+    tables.cells.resize(district_count);
+    for (std::size_t district = 0; district < district_count; district++) {
+      DoubleVector weights;
+      for (auto cell : district_cells_[district]) {
+        const double residents_in_cell = residents[cell];
+        population[district] += residents_in_cell;
+        latitude[district] += residents_in_cell * latitude_[cell];
+        longitude[district] += residents_in_cell * longitude_[cell];
+        mean_travel[district] += residents_in_cell * travel_[cell];
+        weights.push_back(std::pow(residents_in_cell, beta_)
+                          / (1 + travel_[cell]));
+      }
+      tables.cells[district].assign(weights);
+      if (population[district] == 0) { continue; }
+
+      latitude[district] /= population[district];
+      longitude[district] /= population[district];
+      mean_travel[district] /= population[district];
+      auto variance = 0.0;
+      for (auto cell : district_cells_[district]) {
+        variance +=
+            residents[cell]
+            * (std::pow(latitude_[cell] - latitude[district], 2)
+               + std::pow(longitude_[cell] - longitude[district], 2));
+      }
+      variance /= population[district];
+
+      // The mean square distance between two residents is twice the variance
+      spread[district] = std::sqrt(2 * variance);
+    }
+
+    // Gravity model between the districts
+    tables.districts.resize(district_count);
+    DoubleVector weights(district_count);
+    for (std::size_t source = 0; source < district_count; source++) {
+      for (std::size_t destination = 0; destination < district_count;
+           destination++) {
+        const auto distance =
+            source == destination
+                ? distances.distance_between(0, 0, spread[source], 0)
+                : distances.distance_between(
+                    latitude[source], longitude[source], latitude[destination],
+                    longitude[destination]);
+        if (population[source] == 0 || population[destination] == 0
+            || NumberHelpers::is_zero(distance)) {
+          weights[destination] = 0;
+          continue;
+        }
+        weights[destination] =
+            kappa_
+            * (pow(population[source], alpha_)
+               * pow(population[destination], beta_))
+            / pow(distance, gamma_)
+            / (1 + mean_travel[source] + mean_travel[destination]);
+      }
+      tables.districts[source].assign(weights);
+    }
+    return tables;
+  }
+
+  // Return the probabilities of moving from the source to each location that
+  // are implied by the two stages
+  [[nodiscard]] DoubleVector implied_probabilities(const Tables &tables,
+                                                   int from_location) const {
+    DoubleVector results(cell_district_.size(), 0);
+    const auto source = cell_district_[from_location];
+    const auto &districts = tables.districts[source];
+    for (std::size_t ndx = 0; ndx < districts.destinations().size(); ndx++) {
+      const auto district = districts.destinations()[ndx];
+      const auto &cells = tables.cells[district];
+
+      // Within the source district the source cell is excluded
+      auto excluded = 0.0;
+      if (district == source) {
+        for (std::size_t cell = 0; cell < cells.destinations().size(); cell++) {
+          if (cells.destinations()[cell] == cell_position_[from_location]) {
+            excluded = cells.probability(cell);
+          }
+        }
+        if (excluded == 1) { continue; }
+      }
+      for (std::size_t cell = 0; cell < cells.destinations().size(); cell++) {
+        const auto location =
+            district_cells_[district][cells.destinations()[cell]];
+        if (location == from_location) { continue; }
+        results[location] = districts.probability(ndx)
+                            * cells.probability(cell) / (1 - excluded);
+      }
+    }
+    return results;
+  }
+
+protected:
+  void residents_changed() override {
+    tables_ = build_tables(residents_by_location());
+    if (calibration_sources_ > 0 && !calibrated_) {
+      const auto result = calibrate(residents_by_location());
+      LOG(INFO) << fmt::format(
+          "Two-stage movement calibration, mean total variation distance from "
+          "WesolowskiSurface: districts {:.4f}, cells {:.4f}",
+          result.districts, result.cells);
+      calibrated_ = true;
+    }
+  }
+
+public:
+  explicit WesolowskiDistrictSM(const YAML::Node &node) : node_(node) {
+    kappa_ = node["kappa"].as<double>();
+    alpha_ = node["alpha"].as<double>();
+    beta_ = node["beta"].as<double>();
+    gamma_ = node["gamma"].as<double>();
+    calibration_sources_ = node["calibration_sources"]
+                               ? node["calibration_sources"].as<int>()
+                               : 0;
+  }
+
+  ~WesolowskiDistrictSM() override = default;
+
+  void prepare() override {
+    auto &spatial_data = SpatialData::get_instance();
+    if (!spatial_data.has_raster(SpatialData::Districts)) {
+      throw std::runtime_error(
+          fmt::format("{} called without district data loaded", __FUNCTION__));
+    }
+    auto* travel = prepare_surface(SpatialData::Travel);
+    DoubleVector surface(travel, travel + Model::CONFIG->number_of_locations());
+    delete[] travel;
+
+    prepare(spatial_data.district_lookup(), surface,
+            Model::CONFIG->location_db(),
+            Model::CONFIG->spatial_distance_matrix());
+  }
+
+  // Prepare the model from the zero-based district of each cell, the travel
+  // surface, and the locations of the cells
+  void prepare(const IntVector &cell_district, const DoubleVector &travel,
+               const std::vector<Location> &locations,
+               const DistanceMatrix &distances) {
+    travel_ = travel;
+    distances_ = &distances;
+    latitude_.resize(locations.size());
+    longitude_.resize(locations.size());
+    for (std::size_t cell = 0; cell < locations.size(); cell++) {
+      latitude_[cell] = locations[cell].coordinate->latitude;
+      longitude_[cell] = locations[cell].coordinate->longitude;
+    }
+
+    // The district count of the raster is the highest id in the file, which
+    // is one less than the number of districts when they are numbered from
+    // zero, so the size is taken from the lookup instead
+    cell_district_ = cell_district;
+    const auto district_count =
+        cell_district_.empty()
+            ? 0
+            : *std::max_element(cell_district_.begin(), cell_district_.end())
+                  + 1;
+    district_cells_.assign(district_count, IntVector());
+    cell_position_.resize(cell_district_.size());
+    for (std::size_t cell = 0; cell < cell_district_.size(); cell++) {
+      auto &cells = district_cells_[cell_district_[cell]];
+      cell_position_[cell] = static_cast<int>(cells.size());
+      cells.push_back(static_cast<int>(cell));
+    }
+  }
+
+  // Compare the two-stage model with the flat WesolowskiSurfaceSM using the
+  // same parameters for evenly spaced source cells. The total variation
+  // distance (half the L1 distance) between the two is averaged over the
+  // sources, both for the flows to each district and to each cell.
+  [[nodiscard]] Calibration calibrate(const IntVector &residents) const {
+    WesolowskiSurfaceSM flat(node_);
+    flat.prepare(travel_);
+    const auto tables = build_tables(residents);
+
+    const auto locations = static_cast<int>(cell_district_.size());
+    const auto step = std::max(locations / calibration_sources_, 1);
+    Calibration result{0, 0};
+    auto sources = 0;
+    for (auto source = 0; source < locations; source += step) {
+      if (residents[source] == 0) { continue; }
+      auto expected = flat.get_v_relative_out_movement_to_destination(
+          source, locations, *distances_, residents);
+      auto total = 0.0;
+      for (auto value : expected) { total += value; }
+      if (total == 0) { continue; }
+      const auto actual = implied_probabilities(tables, source);
+
+      DoubleVector district_difference(district_cells_.size(), 0);
+      auto cells = 0.0;
+      for (auto location = 0; location < locations; location++) {
+        const auto difference = actual[location] - expected[location] / total;
+        district_difference[cell_district_[location]] += difference;
+        cells += std::fabs(difference);
+      }
+      auto districts = 0.0;
+      for (auto difference : district_difference) {
+        districts += std::fabs(difference);
+      }
+      result.districts += districts / 2;
+      result.cells += cells / 2;
+      sources++;
+    }
+    if (sources > 0) {
+      result.districts /= sources;
+      result.cells /= sources;
+    }
+    return result;
+  }
+
+  // The tables are only built here when the residents differ from those that
+  // the model was last updated with
+  [[nodiscard]] DoubleVector get_v_relative_out_movement_to_destination(
+      const int &from_location, [[maybe_unused]] const int &number_of_locations,
+      [[maybe_unused]] const DistanceMatrix &distances,
+      const IntVector &v_number_of_residents_by_location) const override {
+    if (!tables_.districts.empty()
+        && v_number_of_residents_by_location == residents_by_location()) {
+      return implied_probabilities(tables_, from_location);
+    }
+    return implied_probabilities(
+        build_tables(v_number_of_residents_by_location), from_location);
+  }
+
+  int sample_destination(const int &from_location, double uniform) override {
+    const auto source = cell_district_[from_location];
+    const auto &districts = tables_.districts[source];
+    if (districts.empty()) { return -1; }
+
+    // The uniform is rescaled by the first stage so it can be reused
+    const auto district =
+        districts.destinations()[districts.sample_index(uniform)];
+    const auto &cells = tables_.cells[district];
+    if (cells.empty()) { return -1; }
+    const auto position =
+        district == source
+            ? cells.sample_excluding(uniform, cell_position_[from_location])
+            : cells.sample(uniform);
+    if (position == -1) { return -1; }
+    return district_cells_[district][position];
+  }
+};
+}  // namespace Spatial
+
+#endif
@@ -35,13 +35,14 @@ public:
 
   [[nodiscard]] DoubleVector get_v_relative_out_movement_to_destination(
       const int &from_location, const int &number_of_locations,
-      const DoubleVector &relative_distance_vector,
+      const DistanceMatrix &distances,
       const IntVector &v_number_of_residents_by_location) const override {
     std::vector<double> v_relative_number_of_circulation_by_location(
         number_of_locations, 0);
     for (int target_location = 0; target_location < number_of_locations;
          target_location++) {
-      if (NumberHelpers::is_zero(relative_distance_vector[target_location])) {
+      auto distance = distances(from_location, target_location);
+      if (NumberHelpers::is_zero(distance)) {
         v_relative_number_of_circulation_by_location[target_location] = 0;
       } else {
         // Gravity model:
@@ -50,7 +51,7 @@ public:
             kappa_
             * (pow(v_number_of_residents_by_location[from_location], alpha_)
                * pow(v_number_of_residents_by_location[target_location], beta_))
-            / (pow(relative_distance_vector[target_location], gamma_));
+            / (pow(distance, gamma_));
       }
     }
     return v_relative_number_of_circulation_by_location;
@@ -9,6 +9,7 @@
 #ifndef SPATIAL_WESOLOWSKISURFACESM_H
 #define SPATIAL_WESOLOWSKISURFACESM_H
 
+#include <algorithm>
 #include <cmath>
 
 #include "Core/PropertyMacro.h"
@@ -37,18 +38,26 @@ public:
     gamma_ = node["gamma"].as<double>();
   };
 
-  ~WesolowskiSurfaceSM() override = default;
+  ~WesolowskiSurfaceSM() override { delete[] travel; }
 
   void prepare() override { travel = prepare_surface(SpatialData::Travel); }
 
+  // Use the given travel surface rather than the one loaded from the raster
+  void prepare(const DoubleVector &surface) {
+    delete[] travel;
+    travel = new double[surface.size()];
+    std::copy(surface.begin(), surface.end(), travel);
+  }
+
   [[nodiscard]] DoubleVector get_v_relative_out_movement_to_destination(
       const int &from_location, const int &number_of_locations,
-      const DoubleVector &relative_distance_vector,
+      const DistanceMatrix &distances,
       const IntVector &v_number_of_residents_by_location) const override {
     std::vector<double> results(number_of_locations, 0);
     for (int destination = 0; destination < number_of_locations;
          destination++) {
-      if (NumberHelpers::is_zero(relative_distance_vector[destination])) {
+      auto distance = distances(from_location, destination);
+      if (NumberHelpers::is_zero(distance)) {
         results[destination] = 0;
       } else {
         // Gravity model:
@@ -57,7 +66,7 @@ public:
             kappa_
             * (pow(v_number_of_residents_by_location[from_location], alpha_)
                * pow(v_number_of_residents_by_location[destination], beta_))
-            / (pow(relative_distance_vector[destination], gamma_));
+            / (pow(distance, gamma_));
 
         // Travel penalty: Pr(j|i)' = Pr(j|i) / (1 + t_i + t_j)
         results[destination] =
@@ -12,13 +12,10 @@
 #include "Core/Config/Config.h"
 #include "Core/Random.h"
 #include "Core/Scheduler.h"
-#include "Helpers/NumberHelpers.hxx"
 #include "Model.h"
 #include "Population/Person.h"
 #include "Therapies/DrugType.h"
 
-OBJECTPOOL_IMPL(Drug)
-
 Drug::Drug(DrugType* drug_type)
     : dosing_days_(0),
       start_time_(0),
@@ -26,10 +23,17 @@ Drug::Drug(DrugType* drug_type)
       last_update_value_(1.0),
       last_update_time_(0),
       starting_value_(1.0),
-      drug_type_(drug_type),
-      person_drugs_(nullptr) {}
+      drug_type_(drug_type) {}
 
-Drug::~Drug() = default;
+void Drug::reset(DrugType* drug_type) {
+  dosing_days_ = 0;
+  start_time_ = 0;
+  end_time_ = 0;
+  last_update_value_ = 1.0;
+  last_update_time_ = 0;
+  starting_value_ = 1.0;
+  drug_type_ = drug_type;
+}
 
 void Drug::update() {
   const auto current_time = Model::SCHEDULER->current_time();
@@ -58,13 +62,7 @@ double Drug::get_current_drug_concentration(int currentTime) {
     //        Model::RANDOM->random_uniform_double(-0.1, 0.1);
     return starting_value_;
   } else {
-    const auto temp =
-        NumberHelpers::is_zero(drug_type_->drug_half_life())
-            ? -100
-            : -(days - dosing_days_) * log(2)
-                  / drug_type_->drug_half_life();  //-ai*t = - t* ln2 / tstar
-    if (exp(temp) <= (10.0 / 100.0)) { return 0; }
-    return starting_value_ * exp(temp);
+    return starting_value_ * drug_type_->get_decay_factor(days - dosing_days_);
   }
 }
 
@@ -103,7 +101,6 @@ void Drug::set_number_of_dosing_days(int dosingDays) {
 }
 
 double Drug::get_parasite_killing_rate(int &genotype_id) const {
-  return drug_type_->get_parasite_killing_rate_by_concentration(
-      last_update_value_,
-      Model::CONFIG->EC50_power_n_table()[genotype_id][drug_type_->id()]);
+  return drug_type_->get_parasite_killing_rate(last_update_value_,
+                                               genotype_id);
 }
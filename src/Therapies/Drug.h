@@ -8,13 +8,11 @@
 #ifndef DRUG_H
 #define DRUG_H
 
-#include "Core/ObjectPool.h"
 #include "Core/PropertyMacro.h"
-#include "Population/DrugsInBlood.h"
 
-class Drug {
-  OBJECTPOOL(Drug)
+class DrugType;
 
+class Drug {
   DELETE_COPY_AND_MOVE(Drug)
 
   PROPERTY_REF(int, dosing_days)
@@ -31,13 +29,14 @@ class Drug {
 
   POINTER_PROPERTY(DrugType, drug_type)
 
-  POINTER_PROPERTY(DrugsInBlood, person_drugs)
-
 public:
   explicit Drug(DrugType* drug_type = nullptr);
 
-  //    Drug(const Drug& orig);
-  virtual ~Drug();
+  ~Drug() = default;
+
+  // Reset the drug to the initial state for the given drug type, this allows
+  // the drug slots in DrugsInBlood to be reused.
+  void reset(DrugType* drug_type);
 
   void update();
 
@@ -7,6 +7,7 @@
 
 #include "DrugType.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "Core/Config/Config.h"
@@ -36,6 +37,105 @@ double DrugType::get_parasite_killing_rate_by_concentration(
   return result;
 }
 
+double DrugType::get_parasite_killing_rate(const double &concentration,
+                                           const int &genotype_id) {
+  // Fall back to the exact calculation if the tables were not built
+  if (killing_rate_tables_.empty()) {
+    return get_parasite_killing_rate_by_concentration(
+        concentration, Model::CONFIG->EC50_power_n_table()[genotype_id][id_]);
+  }
+
+  const auto table_id = killing_rate_table_by_genotype_[genotype_id];
+  const auto position = concentration * killing_rate_steps_per_unit_;
+  if (concentration < 0
+      || position >= static_cast<double>(killing_rate_table_intervals_)) {
+    return get_parasite_killing_rate_by_concentration(
+        concentration, killing_rate_table_EC50_power_n_[table_id]);
+  }
+
+  // Linear interpolation between the grid points
+  const auto &table = killing_rate_tables_[table_id];
+  const auto ndx = static_cast<std::size_t>(position);
+  const auto fraction = position - static_cast<double>(ndx);
+  return table[ndx] + fraction * (table[ndx + 1] - table[ndx]);
+}
+
+void DrugType::build_decay_table() {
+  decay_factor_by_day_.clear();
+  if (drug_half_life_ <= 0) { return; }
+
+  // The drug is cut off once the concentration falls to 10% of the starting
+  // value, the exponent matches -ai*t = - t* ln2 / tstar
+  for (auto day = 0;; day++) {
+    const auto factor = exp(-day * log(2) / drug_half_life_);
+    if (factor <= (10.0 / 100.0)) { break; }
+    decay_factor_by_day_.push_back(factor);
+  }
+}
+
+void DrugType::build_killing_rate_table(DoubleVector &table,
+                                        const double &EC50_power_n,
+                                        const std::size_t &intervals) {
+  const auto step = KILLING_RATE_TABLE_MAX_CONCENTRATION / intervals;
+  table.resize(intervals + 1);
+  for (std::size_t ndx = 0; ndx <= intervals; ndx++) {
+    table[ndx] =
+        get_parasite_killing_rate_by_concentration(ndx * step, EC50_power_n);
+  }
+}
+
+void DrugType::build_killing_rate_tables(
+    const DoubleVector2 &EC50_power_n_table) {
+  // Group the genotypes by their EC50^n value
+  killing_rate_table_EC50_power_n_.clear();
+  killing_rate_table_by_genotype_.assign(EC50_power_n_table.size(), 0);
+  for (std::size_t genotype_id = 0; genotype_id < EC50_power_n_table.size();
+       genotype_id++) {
+    const auto value = EC50_power_n_table[genotype_id][id_];
+    auto it = std::find(killing_rate_table_EC50_power_n_.begin(),
+                        killing_rate_table_EC50_power_n_.end(), value);
+    if (it == killing_rate_table_EC50_power_n_.end()) {
+      killing_rate_table_EC50_power_n_.push_back(value);
+      it = killing_rate_table_EC50_power_n_.end() - 1;
+    }
+    killing_rate_table_by_genotype_[genotype_id] = static_cast<int>(
+        std::distance(killing_rate_table_EC50_power_n_.begin(), it));
+  }
+
+  // Double the resolution of the grid until the error at the midpoints, which
+  // is where linear interpolation is worst, is within tolerance
+  const std::size_t max_intervals = 1 << 20;
+  killing_rate_tables_.assign(killing_rate_table_EC50_power_n_.size(),
+                              DoubleVector());
+  std::size_t intervals = 1024;
+  for (;; intervals *= 2) {
+    const auto step = KILLING_RATE_TABLE_MAX_CONCENTRATION / intervals;
+    killing_rate_table_error_ = 0.0;
+    for (std::size_t ndx = 0; ndx < killing_rate_tables_.size(); ndx++) {
+      auto &table = killing_rate_tables_[ndx];
+      const auto EC50_power_n = killing_rate_table_EC50_power_n_[ndx];
+      build_killing_rate_table(table, EC50_power_n, intervals);
+      for (std::size_t i = 0; i < intervals; i++) {
+        const auto exact = get_parasite_killing_rate_by_concentration(
+            (i + 0.5) * step, EC50_power_n);
+        killing_rate_table_error_ =
+            std::max(killing_rate_table_error_,
+                     std::fabs(exact - 0.5 * (table[i] + table[i + 1])));
+      }
+    }
+    if (killing_rate_table_error_ <= KILLING_RATE_TABLE_TOLERANCE) { break; }
+    if (intervals == max_intervals) {
+      LOG(WARNING) << "Killing rate table for " << name_
+                   << " exceeds the tolerance with an error of "
+                   << killing_rate_table_error_;
+      break;
+    }
+  }
+  killing_rate_table_intervals_ = intervals;
+  killing_rate_steps_per_unit_ =
+      intervals / KILLING_RATE_TABLE_MAX_CONCENTRATION;
+}
+
 int DrugType::get_total_duration_of_drug_activity(
     const int &dosing_days) const {
   // CutOffPercent is 10
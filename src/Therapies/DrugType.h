@@ -52,6 +52,35 @@ public:
   virtual double get_parasite_killing_rate_by_concentration(
       const double &concentration, const double &EC50_power_n);
 
+  // Get the killing rate for the genotype at the concentration given from the
+  // killing rate tables, concentrations outside of the table are evaluated
+  // directly.
+  double get_parasite_killing_rate(const double &concentration,
+                                   const int &genotype_id);
+
+  // Get the fraction of the starting concentration remaining the given number
+  // of days after the last dose, zero once the drug is below the cut off.
+  double get_decay_factor(const int &days_since_last_dose) const {
+    return (days_since_last_dose
+            < static_cast<int>(decay_factor_by_day_.size()))
+               ? decay_factor_by_day_[days_since_last_dose]
+               : 0.0;
+  }
+
+  // Build the decay factors by day since the last dose, must be called after
+  // the half-life is set.
+  void build_decay_table();
+
+  // Build the killing rate tables for the genotypes using the EC50^n values
+  // given (genotype x drug), must be called after n and the maximum killing
+  // rate are set.
+  void build_killing_rate_tables(const DoubleVector2 &EC50_power_n_table);
+
+  // Return the maximum absolute error of the killing rate tables.
+  [[nodiscard]] double killing_rate_table_error() const {
+    return killing_rate_table_error_;
+  }
+
   virtual double n() { return n_; }
 
   virtual void set_n(const double &n) { n_ = n; }
@@ -62,8 +91,28 @@ public:
 
   double infer_ec50(Genotype* genotype);
 
+  // Concentrations covered by the killing rate tables
+  static constexpr double KILLING_RATE_TABLE_MAX_CONCENTRATION = 4.0;
+
+  // Maximum absolute error allowed when interpolating the killing rate
+  static constexpr double KILLING_RATE_TABLE_TOLERANCE = 1.0e-6;
+
 private:
   double n_;
+
+  DoubleVector decay_factor_by_day_;
+
+  // Killing rates over the concentration grid, one table per distinct EC50^n
+  // value since most genotypes share their EC50 with other genotypes.
+  DoubleVector2 killing_rate_tables_;
+  DoubleVector killing_rate_table_EC50_power_n_;
+  IntVector killing_rate_table_by_genotype_;
+  double killing_rate_steps_per_unit_{0};
+  std::size_t killing_rate_table_intervals_{0};
+  double killing_rate_table_error_{0};
+
+  void build_killing_rate_table(DoubleVector &table, const double &EC50_power_n,
+                                const std::size_t &intervals);
 };
 
 #endif
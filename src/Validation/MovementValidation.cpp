@@ -17,9 +17,33 @@
 
 #define LOCATION_COUNT_CUTOFF 100
 
-void MovementValidation::add_move(int individual, int source, int destination) {
-  // Record individual movement if need be
+void MovementValidation::set_sampling_rate(double rate) {
+  sample_all_ = rate >= 1.0;
+  sampling_threshold_ =
+      sample_all_ ? UINT64_MAX
+                  : static_cast<std::uint64_t>(rate * 18446744073709551616.0);
+}
+
+// The sample is drawn by hashing the uid of the individual (splitmix64) so
+// that the same individuals are followed for the whole run, and so that the
+// random number stream of the simulation is not disturbed. The index of the
+// individual is not used since it changes as others are removed.
+bool MovementValidation::is_sampled(ul_uid uid) const {
+  if (sample_all_) { return true; }
+  auto hash = static_cast<std::uint64_t>(uid) + 0x9E3779B97F4A7C15ULL;
+  hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+  hash ^= hash >> 31;
+  return hash < sampling_threshold_;
+}
+
+void MovementValidation::add_move(ul_uid uid, int individual, int source,
+                                  int destination) {
+  // Return if the individual is not part of the sample
   auto &instance = get_instance();
+  if (!instance.is_sampled(uid)) { return; }
+
+  // Record individual movement if need be
   if (instance.individual_movement_) {
     instance.reporter->add_fine_move(individual, source, destination);
     return;
@@ -61,12 +85,15 @@ void MovementValidation::write_movement_data() {
   mkdir("./dump", 0777);
 
   // Get the distances matrix and dump it
+  const auto &distance_matrix = Model::CONFIG->spatial_distance_matrix();
+  DoubleVector2 distances(location_count);
+  for (std::size_t ndx = 0; ndx < location_count; ndx++) {
+    distance_matrix.get_row(ndx, distances[ndx]);
+  }
   LOG(INFO) << "Dumping distance matrix to: " << DISTANCES;
-  MatrixWriter<DoubleVector2>::write(Model::CONFIG->spatial_distance_matrix(),
-                                     DISTANCES);
+  MatrixWriter<DoubleVector2>::write(distances, DISTANCES);
 
   // Setup the references and get the population
-  const auto distance_matrix = Model::CONFIG->spatial_distance_matrix();
   const auto spatial = Model::CONFIG->spatial_model();
   IntVector residents_by_location(location_count, 0);
   for (std::size_t ndx = 0; ndx < location_count; ndx++) {
@@ -79,7 +106,7 @@ void MovementValidation::write_movement_data() {
   for (std::size_t ndx = 0; ndx < location_count; ndx++) {
     odds[ndx].resize(location_count, 0);
     odds[ndx] = spatial->get_v_relative_out_movement_to_destination(
-        ndx, location_count, distance_matrix[ndx], residents_by_location);
+        ndx, location_count, distance_matrix, residents_by_location);
   }
 
   LOG(INFO) << "Dumping odds matrix to: " << ODDS;
@@ -6,7 +6,10 @@
 #ifndef MOVEMENTVALIDATION_H
 #define MOVEMENTVALIDATION_H
 
+#include <cstdint>
+
 #include "Core/PropertyMacro.h"
+#include "Helpers/UniqueId.hxx"
 #include "Reporters/Specialist/MovementReporter.h"
 
 class MovementValidation {
@@ -22,6 +25,13 @@ private:
   MovementReporter* reporter;
   std::string query;
 
+  // Individuals whose hashed index is below the threshold are recorded
+  std::uint64_t sampling_threshold_{UINT64_MAX};
+  bool sample_all_{true};
+
+  // Return true if the moves of the individual should be recorded
+  [[nodiscard]] bool is_sampled(ul_uid uid) const;
+
 public:
   // Not supported by singleton.
   MovementValidation(MovementValidation const &) = delete;
@@ -35,12 +45,17 @@ public:
     return instance;
   }
 
-  // Add the movement to the record
-  static void add_move(int individual, int source, int destination);
+  // Add the movement to the record, the uid selects the sample and the
+  // individual is the index that is reported
+  static void add_move(ul_uid uid, int individual, int source,
+                       int destination);
 
   // Set the reporter to use
   void set_reporter(MovementReporter* reporter) { this->reporter = reporter; }
 
+  // Set the fraction of individuals, in (0, 1], whose moves are recorded
+  void set_sampling_rate(double rate);
+
   // Write the movement data that is generated after model initiation.
   static void write_movement_data();
 };
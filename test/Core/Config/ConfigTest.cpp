@@ -116,7 +116,7 @@ TEST_CASE("ConfigTest", "[Core]") {
     REQUIRE(c.number_of_locations() == 9);
 
     REQUIRE(c.spatial_distance_matrix().size() == 9);
-    REQUIRE(c.spatial_distance_matrix()[8].size() == 9);
+    REQUIRE(c.spatial_distance_matrix()(8, 8) == 0);
 
     REQUIRE(c.seasonal_info().A == DoubleVector(9, 1.0));
 
@@ -0,0 +1,96 @@
+/*
+ * Check that deferring the updates of the individuals while the population is
+ * free of parasites does not change the monthly statistics.
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Core/Scheduler.h"
+#include "Core/TypeDef.h"
+#include "MDC/MainDataCollector.h"
+#include "Model.h"
+#include "Reporters/Reporter.h"
+#include "yaml-cpp/yaml.h"
+
+namespace {
+struct MonthlyStatistics {
+  std::vector<DoubleVector> immune;
+  std::vector<IntVector> population;
+  int deferred_reports{0};
+};
+
+// Record the statistics at each monthly report, the reporter is deleted with
+// the model so the values are kept in the statistics passed in
+class MonthlyStatisticsReporter : public Reporter {
+  MonthlyStatistics &statistics_;
+
+public:
+  explicit MonthlyStatisticsReporter(MonthlyStatistics &statistics)
+      : statistics_(statistics) {}
+
+  void initialize(int job_number, const std::string &path) override {}
+
+  void before_run() override {}
+
+  void after_run() override {}
+
+  void begin_time_step() override {}
+
+  void monthly_report() override {
+    Model::MAIN_DATA_COLLECTOR->perform_immune_statistic();
+    statistics_.immune.push_back(
+        Model::MAIN_DATA_COLLECTOR->total_immune_by_location());
+    statistics_.population.push_back(
+        Model::MAIN_DATA_COLLECTOR->popsize_residence_by_location());
+    if (Model::SCHEDULER->fast_forward()) { statistics_.deferred_reports++; }
+  }
+};
+
+// Run two years of the example configuration without any parasites
+MonthlyStatistics run_without_parasites(bool fast_forward) {
+  auto config =
+      YAML::LoadFile(std::string(MASIM_EXAMPLES_DIR) + "/simple.yml");
+  config["ending_date"] = "1992/1/1";
+  config["start_of_comparison_period"] = "1991/1/1";
+  config["artificial_rescaling_of_population_size"] = 0.05;
+  config["initial_parasite_info"] = YAML::Node(YAML::NodeType::Sequence);
+  config["events"] = YAML::Node(YAML::NodeType::Sequence);
+  config["fast_forward_without_parasites"] = fast_forward;
+
+  const std::string filename = "fast_forward_test.yml";
+  std::ofstream(filename) << config;
+
+  MonthlyStatistics statistics;
+  auto* model = new Model();
+  model->set_config_filename(filename);
+  model->set_reporter_type("Null");
+  model->initialize();
+  model->add_reporter(new MonthlyStatisticsReporter(statistics));
+  model->run();
+  delete model;
+
+  std::remove(filename.c_str());
+  return statistics;
+}
+}  // namespace
+
+TEST_CASE("Fast forward does not change the monthly statistics",
+          "[fast_forward]") {
+  const auto expected = run_without_parasites(false);
+  const auto result = run_without_parasites(true);
+  REQUIRE(expected.deferred_reports == 0);
+  REQUIRE(result.deferred_reports > 0);
+
+  REQUIRE(result.immune.size() == expected.immune.size());
+  for (std::size_t month = 0; month < expected.immune.size(); month++) {
+    REQUIRE(result.population[month] == expected.population[month]);
+    for (std::size_t loc = 0; loc < expected.immune[month].size(); loc++) {
+      const auto value = expected.immune[month][loc];
+      REQUIRE(std::fabs(result.immune[month][loc] - value) <= 1e-9 * value);
+    }
+  }
+}
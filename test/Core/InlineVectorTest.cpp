@@ -0,0 +1,37 @@
+#include "Core/InlineVector.hxx"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Inline vector stores small collections inline", "[inline vector]") {
+  InlineVector<int*, 4> vector;
+  int values[4] = {0, 1, 2, 3};
+
+  REQUIRE(vector.empty());
+  for (auto &value : values) { vector.push_back(&value); }
+
+  REQUIRE(vector.size() == 4);
+  REQUIRE(vector.is_inline());
+  REQUIRE(vector.at(2) == &values[2]);
+
+  // Swap-and-pop removal as used by the clonal parasite populations
+  vector[1] = vector.back();
+  vector.pop_back();
+  REQUIRE(vector.size() == 3);
+  REQUIRE(vector[1] == &values[3]);
+  REQUIRE_THROWS_AS(vector.at(3), std::out_of_range);
+}
+
+TEST_CASE("Inline vector spills over to the heap", "[inline vector]") {
+  InlineVector<int*, 2> vector;
+  int values[5] = {0, 1, 2, 3, 4};
+
+  for (auto &value : values) { vector.push_back(&value); }
+  REQUIRE(vector.size() == 5);
+  REQUIRE_FALSE(vector.is_inline());
+
+  auto ndx = 0;
+  for (auto* value : vector) { REQUIRE(*value == ndx++); }
+
+  vector.clear();
+  REQUIRE(vector.empty());
+}
@@ -0,0 +1,104 @@
+#include "Core/Philox.hxx"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+#include "Core/Random.h"
+
+TEST_CASE("Philox matches the reference known answers", "[philox]") {
+  // Known answer tests from the Random123 distribution
+  REQUIRE(Philox4x32::generate({0, 0, 0, 0}, {0, 0})
+          == Philox4x32::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c,
+                                 0x9b00dbd8});
+  REQUIRE(Philox4x32::generate({0xffffffff, 0xffffffff, 0xffffffff,
+                                0xffffffff},
+                               {0xffffffff, 0xffffffff})
+          == Philox4x32::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6,
+                                 0x6d5451fd});
+  REQUIRE(Philox4x32::generate({0x243f6a88, 0x85a308d3, 0x13198a2e,
+                                0x03707344},
+                               {0xa4093822, 0x299f31d0})
+          == Philox4x32::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420,
+                                 0x24126ea1});
+}
+
+TEST_CASE("Random substreams are reproducible and independent", "[philox]") {
+  Random random;
+  random.initialize(42);
+
+  auto draw = [&](RandomPhase phase, std::uint64_t id, std::uint32_t day) {
+    auto stream = random.substream(phase, id, day);
+    std::vector<double> values;
+    for (auto ndx = 0; ndx < 10; ndx++) {
+      values.push_back(stream.random_flat(0.0, 1.0));
+    }
+    return values;
+  };
+
+  // Drawing from the main stream, or other substreams, does not change the
+  // values drawn from a substream
+  const auto expected = draw(RandomPhase::INFECTION, 7, 100);
+  random.random_flat(0.0, 1.0);
+  draw(RandomPhase::INFECTION, 8, 100);
+  REQUIRE(draw(RandomPhase::INFECTION, 7, 100) == expected);
+
+  // Changing any part of the key gives a different substream
+  REQUIRE(draw(RandomPhase::INFECTION, 8, 100) != expected);
+  REQUIRE(draw(RandomPhase::INFECTION, 7, 101) != expected);
+  REQUIRE(draw(RandomPhase::CIRCULATION, 7, 100) != expected);
+}
+
+TEST_CASE("Random batch sampling stays within bounds", "[philox]") {
+  Random random;
+  random.initialize(42);
+
+  // Filling across the block boundaries gives the same values as drawing them
+  // one at a time from the stream
+  auto first = random.substream(RandomPhase::GENERAL, 1, 1);
+  auto second = random.substream(RandomPhase::GENERAL, 1, 1);
+  std::vector<double> values(1001);
+  first.fill_uniform(values.data(), 3);
+  first.fill_uniform(values.data() + 3, values.size() - 3);
+  for (auto value : values) { REQUIRE(value == second.random_uniform()); }
+
+  std::vector<unsigned long> indices(10000);
+  random.fill_uniform_int(7, indices.data(), indices.size());
+  std::vector<int> counts(7, 0);
+  for (auto index : indices) {
+    REQUIRE(index < 7);
+    counts[index]++;
+  }
+  for (auto count : counts) { REQUIRE(count > 1000); }
+
+  // The Poisson draws have the expected mean, for means both below and above
+  // the inversion limit
+  for (auto mean : {0.0, 0.5, 4.0, 25.0}) {
+    std::vector<double> means(10000, mean);
+    std::vector<int> draws(means.size());
+    random.fill_poisson(means.data(), draws.data(), means.size());
+    auto total = 0.0;
+    for (auto draw : draws) {
+      REQUIRE(draw >= 0);
+      total += draw;
+    }
+    REQUIRE(std::fabs(total / draws.size() - mean) < 0.05 * mean + 0.01);
+  }
+}
+
+TEST_CASE("Random batch sampling benchmark", "[!benchmark]") {
+  Random random;
+  random.initialize(42);
+  std::vector<double> values(100000);
+
+  BENCHMARK("random_flat") {
+    for (auto &value : values) { value = random.random_flat(0.0, 1.0); }
+    return values.back();
+  };
+
+  BENCHMARK("fill_uniform") {
+    random.fill_uniform(values.data(), values.size());
+    return values.back();
+  };
+}
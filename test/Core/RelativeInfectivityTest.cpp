@@ -0,0 +1,66 @@
+#include <gsl/gsl_cdf.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+#include "Core/RelativeInfectivity.hxx"
+
+namespace {
+// Parameters as derived from the example configurations by the YAML converter
+RelativeInfectivity make_relative_infectivity() {
+  RelativeInfectivity relative_infectivity{};
+  const auto sigma = 3.91;
+  const auto ro = 0.00031;
+  const auto d_star = 1 / 3.0;
+  relative_infectivity.ro_star = (log(ro) - log(d_star)) / sigma;
+  relative_infectivity.sigma = log(10) / sigma;
+  relative_infectivity.build_curve();
+  return relative_infectivity;
+}
+
+// The original calculation from Person::relative_infectivity
+double gsl_relative_infectivity(const RelativeInfectivity &ri,
+                                double log10_density) {
+  const auto p = gsl_cdf_ugaussian_P(log10_density * ri.sigma + ri.ro_star);
+  return p * p + 0.01;
+}
+}  // namespace
+
+TEST_CASE("Relative infectivity curve matches the GSL calculation",
+          "[relative infectivity]") {
+  const auto ri = make_relative_infectivity();
+
+  std::vector<double> densities;
+  for (auto density = -10.0; density <= 12.0; density += 0.0007) {
+    densities.push_back(density);
+  }
+  for (std::size_t ndx = 0; ndx < densities.size(); ndx++) {
+    const auto expected = gsl_relative_infectivity(ri, densities[ndx]);
+    REQUIRE(std::fabs(ri(densities[ndx]) - expected) < 1e-5);
+  }
+}
+
+TEST_CASE("Relative infectivity benchmark", "[!benchmark]") {
+  const auto ri = make_relative_infectivity();
+  std::vector<double> densities;
+  for (auto ndx = 0; ndx < 100000; ndx++) {
+    densities.push_back(-5.0 + 11.0 * ndx / 100000);
+  }
+  std::vector<double> results(densities.size());
+
+  BENCHMARK("GSL") {
+    for (std::size_t ndx = 0; ndx < densities.size(); ndx++) {
+      results[ndx] = gsl_relative_infectivity(ri, densities[ndx]);
+    }
+    return results.back();
+  };
+
+  BENCHMARK("Table") {
+    for (std::size_t ndx = 0; ndx < densities.size(); ndx++) {
+      results[ndx] = ri(densities[ndx]);
+    }
+    return results.back();
+  };
+}
@@ -0,0 +1,43 @@
+#include "Core/ThreadPool.h"
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Thread pool runs each chunk once", "[thread pool]") {
+  for (auto threads : {1, 4}) {
+    ThreadPool pool(threads);
+    REQUIRE(pool.threads() == threads);
+
+    // Repeat to check that the pool can be reused
+    for (auto repeat = 0; repeat < 10; repeat++) {
+      const std::size_t count = 1000, grain = 64;
+      std::vector<int> visits(count, 0);
+      std::vector<std::size_t> chunk_begin(
+          ThreadPool::chunk_count(count, grain), count);
+      pool.parallel_for(count, grain, [&](std::size_t chunk, std::size_t begin,
+                                          std::size_t end) {
+        chunk_begin[chunk] = begin;
+        for (auto ndx = begin; ndx < end; ndx++) { visits[ndx]++; }
+      });
+      REQUIRE(visits == std::vector<int>(count, 1));
+      for (std::size_t chunk = 0; chunk < chunk_begin.size(); chunk++) {
+        REQUIRE(chunk_begin[chunk] == chunk * grain);
+      }
+    }
+  }
+}
+
+TEST_CASE("Thread pool rethrows exceptions from the work", "[thread pool]") {
+  ThreadPool pool(4);
+  std::atomic<int> chunks{0};
+  REQUIRE_THROWS_AS(
+      pool.parallel_for(100, 10,
+                        [&](std::size_t chunk, std::size_t, std::size_t) {
+                          chunks++;
+                          if (chunk == 3) { throw std::runtime_error("test"); }
+                        }),
+      std::runtime_error);
+  REQUIRE(chunks == 10);
+}
@@ -0,0 +1,49 @@
+#include "Helpers/LookupTables.hxx"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <stdexcept>
+
+#include "Core/Config/CustomConfigItem.h"
+
+TEST_CASE("Exponential decay table matches exp", "[lookup tables]") {
+  // Acquire and decay rates spanning those used by the immune system
+  for (auto rate : {0.0, 0.00125, 0.0025, 0.0315, 0.5}) {
+    const ExponentialDecayTable table(rate);
+    for (auto duration = 0;
+         duration < ExponentialDecayTable::DURATION_LIMIT + 100; duration++) {
+      const auto expected = std::exp(-rate * duration);
+      REQUIRE(std::fabs(table(duration) - expected) <= 1e-14);
+    }
+  }
+}
+
+TEST_CASE("Clinical progression table bounds the interpolation error",
+          "[lookup tables]") {
+  // Parameters from the example configurations, and a steeper curve
+  const auto max_probability = 0.99;
+  const auto midpoint = 0.4;
+  for (auto slope : {4.0, 12.0}) {
+    auto function = [&](double immune) {
+      return max_probability / (1 + std::pow((immune / midpoint), slope));
+    };
+    const InterpolationTable table(
+        0.0, 1.0, immune_system_information::CLINICAL_PROGRESSION_INTERVALS,
+        function);
+
+    auto max_error = 0.0;
+    for (auto ndx = 0; ndx <= 100000; ndx++) {
+      const auto immune = ndx / 100000.0;
+      max_error =
+          std::fmax(max_error, std::fabs(table(immune) - function(immune)));
+    }
+    REQUIRE(max_error < 1e-5);
+  }
+}
+
+TEST_CASE("Empty interpolation table throws when evaluated",
+          "[lookup tables]") {
+  const InterpolationTable table;
+  REQUIRE(table.empty());
+  REQUIRE_THROWS_AS(table(0.5), std::logic_error);
+}
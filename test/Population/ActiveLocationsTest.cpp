@@ -0,0 +1,135 @@
+/*
+ * Check that the active locations tracked by the population match a scan of
+ * every location over a short run with infections seeded in one location.
+ */
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Core/Config/Config.h"
+#include "Core/TypeDef.h"
+#include "Model.h"
+#include "Population/Person.h"
+#include "Population/Population.h"
+#include "Population/Properties/PersonIndexByLocationStateAgeClass.h"
+#include "Reporters/Reporter.h"
+#include "yaml-cpp/yaml.h"
+
+namespace {
+// Return the locations with an infected host or any force of infection, found
+// by scanning all of them
+IntVector scan_locations() {
+  auto* population = Model::POPULATION;
+  auto* pi =
+      population->get_person_index<PersonIndexByLocationStateAgeClass>();
+  const auto any_non_zero = [](const DoubleVector &values) {
+    for (auto value : values) {
+      if (value != 0.0) { return true; }
+    }
+    return false;
+  };
+
+  const auto &current =
+      population->current_force_of_infection_by_location_parasite_type();
+  const auto &interrupted =
+      population
+          ->interupted_feeding_force_of_infection_by_location_parasite_type();
+
+  IntVector locations;
+  for (std::size_t loc = 0; loc < Model::CONFIG->number_of_locations();
+       loc++) {
+    auto active = any_non_zero(current[loc]) || any_non_zero(interrupted[loc]);
+    for (const auto &day :
+         population->force_of_infection_for7days_by_location_parasite_type()) {
+      active = active || any_non_zero(day[loc]);
+    }
+    for (auto hs = static_cast<int>(Person::EXPOSED);
+         hs <= static_cast<int>(Person::CLINICAL); hs++) {
+      for (const auto &persons : pi->vPerson()[loc][hs]) {
+        active = active || !persons.empty();
+      }
+    }
+    if (active) { locations.push_back(static_cast<int>(loc)); }
+  }
+  return locations;
+}
+
+// Compare the active locations with the scan at the start of each day, before
+// the infection event iterates over them
+class ActiveLocationsReporter : public Reporter {
+  IntVector previous_;
+  int &gained_;
+  int &dropped_;
+
+public:
+  ActiveLocationsReporter(int &gained, int &dropped)
+      : previous_(Model::POPULATION->active_locations()),
+        gained_(gained),
+        dropped_(dropped) {}
+
+  void initialize(int job_number, const std::string &path) override {}
+
+  void before_run() override {}
+
+  void after_run() override {}
+
+  void monthly_report() override {}
+
+  void begin_time_step() override {
+    // A location outside of the list has no force of infection on any of the
+    // tracking days, so a scan of all the locations would skip it without
+    // drawing the number of bites
+    const auto &active = Model::POPULATION->active_locations();
+    REQUIRE(active == scan_locations());
+
+    for (auto loc : active) {
+      if (std::find(previous_.begin(), previous_.end(), loc)
+          == previous_.end()) {
+        gained_++;
+      }
+    }
+    for (auto loc : previous_) {
+      if (std::find(active.begin(), active.end(), loc) == active.end()) {
+        dropped_++;
+      }
+    }
+    previous_ = active;
+  }
+};
+}  // namespace
+
+TEST_CASE("Active locations follow the infected hosts", "[population]") {
+  // Seed the infections in the first location only, with a low transmission
+  // rate and some movement so that the other locations are visited by
+  // infected hosts and clear again
+  auto config =
+      YAML::LoadFile(std::string(MASIM_EXAMPLES_DIR) + "/simple.yml");
+  config["ending_date"] = "1992/1/1";
+  config["start_of_comparison_period"] = "1991/1/1";
+  config["artificial_rescaling_of_population_size"] = 0.1;
+  config["location_db"]["beta_by_location"] = std::vector<double>{0.01};
+  config["circulation_info"]["circulation_percent"] = 0.01;
+  config["initial_parasite_info"][0]["location_id"] = 0;
+  config["events"] = YAML::Node(YAML::NodeType::Sequence);
+
+  const std::string filename = "active_locations_test.yml";
+  std::ofstream(filename) << config;
+
+  auto gained = 0;
+  auto dropped = 0;
+  auto* model = new Model();
+  model->set_config_filename(filename);
+  model->set_reporter_type("Null");
+  model->initialize();
+  REQUIRE(Model::POPULATION->active_locations() == IntVector{0});
+  model->add_reporter(new ActiveLocationsReporter(gained, dropped));
+  model->run();
+  delete model;
+  std::remove(filename.c_str());
+
+  REQUIRE(gained > 0);
+  REQUIRE(dropped > 0);
+}
@@ -0,0 +1,106 @@
+/*
+ * Benchmarks for the hot paths that draw from Random, build with and without
+ * ENABLE_RANDOM_MOCKING to compare the statically bound calls against virtual
+ * dispatch.
+ */
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+#include "Core/Config/Config.h"
+#include "Core/Random.h"
+#include "Core/Scheduler.h"
+#include "Model.h"
+#include "Parasites/Genotype.h"
+#include "Parasites/GenotypeDatabase.h"
+#include "Population/ClonalParasitePopulation.h"
+#include "Population/DrugsInBlood.h"
+#include "Population/ImmuneComponent/InfantImmuneComponent.h"
+#include "Population/ImmuneSystem.h"
+#include "Population/Person.h"
+#include "Population/SingleHostClonalParasitePopulations.h"
+#include "Therapies/Drug.h"
+#include "Therapies/DrugType.h"
+#include "yaml-cpp/yaml.h"
+
+TEST_CASE("Person hot path benchmark", "[!benchmark]") {
+  auto* model = new Model();
+  Model::RANDOM->initialize(42);
+  Model::SCHEDULER->set_current_time(0);
+  Model::CONFIG->parasite_density_level().log_parasite_density_cured = -4.699;
+
+  auto* person = new Person();
+  person->init();
+  person->immune_system()->set_immune_component(new InfantImmuneComponent());
+  person->set_latest_update_time(0);
+
+  BENCHMARK("inflict_bite") {
+    // Start from no infections so the list does not grow across the runs
+    person->today_infections()->clear();
+    auto infected = 0;
+    for (auto ndx = 0; ndx < 10000; ndx++) {
+      infected += person->inflict_bite(0) ? 1 : 0;
+    }
+    return infected;
+  };
+
+  // Two genotypes on a single locus that mutate into each other, with the
+  // second resistant to both drugs, so the mutation rolls, and the draws that
+  // follow a successful roll, are exercised
+  auto &genotype_info = Model::CONFIG->genotype_info();
+  genotype_info.loci_vector.resize(1);
+  genotype_info.loci_vector[0].alleles.resize(2);
+  for (auto allele = 0; allele < 2; allele++) {
+    auto &value = genotype_info.loci_vector[0].alleles[allele];
+    value.value = allele;
+    value.mutation_values = {1 - allele};
+    value.mutation_level = allele;
+    value.daily_cost_of_resistance = 0;
+  }
+  Model::CONFIG->genotype_db.set_value(YAML::Node());
+  const DoubleVector2 EC50_power_n_table = {
+      {std::pow(0.75, 4), std::pow(0.75, 4)},
+      {std::pow(1.2, 4), std::pow(1.2, 4)}};
+  Model::CONFIG->EC50_power_n_table() = EC50_power_n_table;
+
+  // Two drugs in the blood at full concentration
+  std::vector<DrugType> drug_types(2);
+  for (auto ndx = 0; ndx < 2; ndx++) {
+    auto &drug_type = drug_types[ndx];
+    drug_type.set_id(ndx);
+    drug_type.set_maximum_parasite_killing_rate(0.999);
+    drug_type.set_n(4);
+    drug_type.set_p_mutation(0.005);
+    drug_type.set_k(4);
+    drug_type.build_killing_rate_tables(EC50_power_n_table);
+    person->drugs_in_blood()->add_drug(&drug_type);
+  }
+  auto* genotype = Model::CONFIG->genotype_db()->at(0);
+  const auto clones = 4;
+  for (auto ndx = 0; ndx < clones; ndx++) {
+    person->all_clonal_parasite_populations()->add(genotype);
+  }
+
+  for (auto aggregate : {false, true}) {
+    Model::CONFIG->aggregate_mutation_sampling() = aggregate;
+    BENCHMARK(aggregate ? "update_by_drugs, aggregated"
+                        : "update_by_drugs, per roll") {
+      // Restore the genotypes and densities, otherwise the clones become
+      // resistant and the drugs clear them
+      for (auto* clone :
+           *person->all_clonal_parasite_populations()->parasites()) {
+        clone->set_genotype(genotype);
+        clone->set_last_update_log10_parasite_density(4.0);
+      }
+      for (auto ndx = 0; ndx < 1000; ndx++) {
+        person->all_clonal_parasite_populations()->update_by_drugs(
+            person->drugs_in_blood());
+      }
+      return person->all_clonal_parasite_populations()->size();
+    };
+  }
+
+  delete person;
+  delete model;
+}
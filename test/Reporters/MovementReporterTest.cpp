@@ -0,0 +1,150 @@
+/*
+ * Check the movement data written to SQLite by the MovementReporter, and the
+ * sample of individuals selected by MovementValidation.
+ */
+#include <fmt/format.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Core/Scheduler.h"
+#include "Helpers/SQLiteDatabase.h"
+#include "Model.h"
+#include "Reporters/Specialist/MovementReporter.h"
+#include "Validation/MovementValidation.h"
+
+namespace {
+// The reporter names the database after the job number in the path
+const int JOB_NUMBER = 0;
+
+std::string output_path() {
+  return (std::filesystem::temp_directory_path() / "").string();
+}
+
+std::string database_path() {
+  return fmt::format("{}movement_{}.db", output_path(), JOB_NUMBER);
+}
+
+// Return the level and sampling rate recorded by the reporter
+std::tuple<std::string, double> read_settings(SQLiteDatabase &db) {
+  auto* stmt = db.prepare("SELECT level, samplingrate FROM movementsettings;");
+  REQUIRE(sqlite3_step(stmt) == SQLITE_ROW);
+  std::tuple<std::string, double> settings{
+      reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+      sqlite3_column_double(stmt, 1)};
+  REQUIRE(sqlite3_step(stmt) == SQLITE_DONE);
+  sqlite3_finalize(stmt);
+  return settings;
+}
+}  // namespace
+
+TEST_CASE("MovementReporter aggregates the coarse moves by month",
+          "[movement]") {
+  auto* model = new Model();
+  model->set_cell_movement(true);
+  model->set_movement_sampling_rate(1.0);
+
+  {
+    MovementReporter reporter;
+    reporter.initialize(JOB_NUMBER, output_path());
+
+    // Moves in the first month are reported at the start of the second
+    Model::SCHEDULER->set_current_time(31);
+    for (auto ndx = 0; ndx < 3; ndx++) { reporter.add_coarse_move(ndx, 1, 2); }
+    reporter.add_coarse_move(3, 2, 1);
+    reporter.monthly_report();
+
+    // Moves after the last report are written when the run ends
+    Model::SCHEDULER->set_current_time(45);
+    reporter.add_coarse_move(0, 3, 4);
+    reporter.add_coarse_move(1, 3, 4);
+    reporter.after_run();
+  }
+
+  {
+    SQLiteDatabase db(database_path());
+    REQUIRE(read_settings(db) == std::make_tuple(std::string("C"), 1.0));
+
+    std::vector<std::tuple<int, int, int, int>> rows;
+    auto* stmt = db.prepare(
+        "SELECT timestep, count, source, destination FROM districtmovement "
+        "ORDER BY timestep, source, destination;");
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      rows.emplace_back(
+          sqlite3_column_int(stmt, 0), sqlite3_column_int(stmt, 1),
+          sqlite3_column_int(stmt, 2), sqlite3_column_int(stmt, 3));
+    }
+    sqlite3_finalize(stmt);
+
+    const std::vector<std::tuple<int, int, int, int>> expected = {
+        {31, 3, 1, 2}, {31, 1, 2, 1}, {45, 2, 3, 4}};
+    REQUIRE(rows == expected);
+  }
+
+  std::remove(database_path().c_str());
+  delete model;
+}
+
+TEST_CASE("MovementValidation follows the same sample of individuals",
+          "[movement]") {
+  const auto rate = 0.25;
+  const auto individuals = 10000;
+
+  auto* model = new Model();
+  model->set_individual_movement(true);
+  model->set_movement_sampling_rate(rate);
+
+  {
+    MovementReporter reporter;
+    reporter.initialize(JOB_NUMBER, output_path());
+
+    auto &validation = MovementValidation::get_instance();
+    validation.set_individual_movement(true);
+    validation.set_reporter(&reporter);
+    validation.set_sampling_rate(rate);
+
+    // Every individual moves out and back in different months, so a sampled
+    // individual should have both moves recorded
+    Model::SCHEDULER->set_current_time(10);
+    for (auto uid = 0; uid < individuals; uid++) {
+      MovementValidation::add_move(uid, uid, 0, 1);
+    }
+    reporter.monthly_report();
+    Model::SCHEDULER->set_current_time(40);
+    for (auto uid = 0; uid < individuals; uid++) {
+      MovementValidation::add_move(uid, uid, 1, 0);
+    }
+    reporter.after_run();
+
+    validation.set_individual_movement(false);
+    validation.set_reporter(nullptr);
+    validation.set_sampling_rate(1.0);
+  }
+
+  {
+    SQLiteDatabase db(database_path());
+    REQUIRE(read_settings(db) == std::make_tuple(std::string("I"), rate));
+
+    std::map<int, int> moves;
+    auto* stmt = db.prepare("SELECT individualid FROM movement;");
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      moves[sqlite3_column_int(stmt, 0)]++;
+    }
+    sqlite3_finalize(stmt);
+
+    for (const auto &[individual, count] : moves) { REQUIRE(count == 2); }
+
+    // The binomial standard deviation is about 43 individuals
+    const auto sampled = static_cast<double>(moves.size());
+    REQUIRE(std::abs(sampled - rate * individuals) < 250);
+  }
+
+  std::remove(database_path().c_str());
+  delete model;
+}
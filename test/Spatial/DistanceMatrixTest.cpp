@@ -0,0 +1,66 @@
+#include "Spatial/DistanceMatrix.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Spatial/Coordinate.h"
+
+using namespace Spatial;
+
+TEST_CASE("Distances computed on demand match the Haversine distance",
+          "[Spatial]") {
+  // Enough locations that the matrix is not stored
+  std::vector<Location> locations;
+  for (auto ndx = 0; ndx <= static_cast<int>(DistanceMatrix::DENSE_LIMIT);
+       ndx++) {
+    locations.emplace_back(ndx, -30.0f + 0.013f * ndx, 20.0f + 0.007f * ndx, 0);
+  }
+  const auto matrix = DistanceMatrix::from_coordinates(locations);
+  REQUIRE(matrix.size() == locations.size());
+  REQUIRE_FALSE(matrix.is_dense());
+
+  DoubleVector row;
+  for (auto from : {0, 17, 4096}) {
+    matrix.get_row(from, row);
+    REQUIRE(row.size() == locations.size());
+    for (std::size_t to = 0; to < locations.size(); to += 31) {
+      const auto expected = Coordinate::calculate_distance_in_km(
+          *locations[from].coordinate, *locations[to].coordinate);
+      REQUIRE(matrix(from, to) == expected);
+      REQUIRE(row[to] == expected);
+    }
+  }
+}
+
+TEST_CASE("Raster distances are stored for small rasters", "[Spatial]") {
+  std::vector<Location> locations;
+  locations.emplace_back(0, 0, 0, 0);
+  locations.emplace_back(1, 3, 4, 0);
+  const auto matrix = DistanceMatrix::from_raster(locations, 5);
+  REQUIRE(matrix.is_dense());
+  REQUIRE(matrix(0, 0) == 0);
+  REQUIRE(matrix(0, 1) == 25);
+  REQUIRE(matrix(1, 0) == 25);
+}
+
+TEST_CASE("Locations within a radius match a full scan", "[Spatial]") {
+  // Raster cells in row major order, as they are generated from the raster
+  std::vector<Location> locations;
+  for (auto row = 0; row < 40; row++) {
+    for (auto col = 0; col < 30; col++) {
+      locations.emplace_back(static_cast<int>(locations.size()), row, col, 0);
+    }
+  }
+  const auto matrix = DistanceMatrix::from_raster(locations, 5);
+
+  std::vector<int> within;
+  for (auto from : {0, 455, 1199}) {
+    for (auto radius : {0.0, 5.0, 27.5, 1000.0}) {
+      matrix.get_within(from, radius, within);
+      std::vector<int> expected;
+      for (auto to = 0; to < static_cast<int>(locations.size()); to++) {
+        if (matrix(from, to) <= radius) { expected.push_back(to); }
+      }
+      REQUIRE(within == expected);
+    }
+  }
+}
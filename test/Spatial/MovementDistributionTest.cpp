@@ -0,0 +1,143 @@
+#include "Spatial/MovementDistribution.hxx"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+#include "Core/Random.h"
+
+using namespace Spatial;
+
+TEST_CASE("Movement distribution matches the weights", "[Spatial]") {
+  const std::vector<double> weights{0.0, 2.0, 0.0, 1.0, 5.0, 0.0, 0.5, 1.5};
+  MovementDistribution distribution;
+  REQUIRE_FALSE(distribution.prepared());
+  distribution.assign(weights);
+  REQUIRE(distribution.prepared());
+  REQUIRE(distribution.destinations() == std::vector<int>{1, 3, 4, 6, 7});
+
+  // Evenly spaced quantiles land on each destination in proportion to its
+  // weight, and never on the zero weight locations
+  const auto draws = 10000;
+  std::vector<int> counts(weights.size(), 0);
+  for (auto ndx = 0; ndx < draws; ndx++) {
+    counts[distribution.sample((ndx + 0.5) / draws)]++;
+  }
+  for (std::size_t ndx = 0; ndx < weights.size(); ndx++) {
+    REQUIRE(std::abs(counts[ndx] - draws * weights[ndx] / 10.0) <= 1);
+  }
+  REQUIRE(distribution.sample(0.0) == 1);
+  REQUIRE(distribution.sample(0.9999999999) == 7);
+  REQUIRE(distribution.probability(2) == 0.5);
+
+  distribution.assign(std::vector<double>(4, 0.0));
+  REQUIRE(distribution.prepared());
+  REQUIRE(distribution.empty());
+}
+
+TEST_CASE("Movement distribution supports two-stage sampling", "[Spatial]") {
+  MovementDistribution distribution;
+  distribution.assign({1.0, 3.0, 0.0, 4.0});
+
+  // The uniform is rescaled within the interval of the destination
+  auto uniform = 0.3125;
+  REQUIRE(distribution.destinations()[distribution.sample_index(uniform)] == 1);
+  REQUIRE(std::abs(uniform - 0.5) < 1e-12);
+
+  // Excluding a destination draws from the remainder in proportion
+  const auto draws = 10000;
+  std::vector<int> counts(4, 0);
+  for (auto ndx = 0; ndx < draws; ndx++) {
+    counts[distribution.sample_excluding((ndx + 0.5) / draws, 1)]++;
+  }
+  REQUIRE(counts == std::vector<int>{2000, 0, 0, 8000});
+  REQUIRE(distribution.sample_excluding(0.5, 2) == distribution.sample(0.5));
+
+  distribution.assign({0.0, 2.0});
+  REQUIRE(distribution.sample_excluding(0.5, 1) == -1);
+}
+
+TEST_CASE("Truncated movement distribution is close to the full one",
+          "[Spatial]") {
+  // Gravity kernel for a corner of a 100 x 100 raster
+  const auto size = 100;
+  std::vector<double> weights(size * size);
+  for (auto row = 0; row < size; row++) {
+    for (auto col = 0; col < size; col++) {
+      const auto distance = std::hypot(row, col);
+      weights[row * size + col] =
+          (distance == 0) ? 0.0 : std::pow(1 + distance / 2.0, -3.0);
+    }
+  }
+  MovementDistribution full;
+  full.assign(weights);
+
+  for (auto truncated : {1e-2, 1e-3}) {
+    MovementDistribution distribution;
+    distribution.assign(weights, truncated);
+    REQUIRE(distribution.destinations().size()
+            < full.destinations().size());
+    REQUIRE(std::is_sorted(distribution.destinations().begin(),
+                           distribution.destinations().end()));
+
+    // Total variation distance from the full distribution
+    auto distance = 0.0;
+    std::size_t index = 0;
+    for (std::size_t ndx = 0; ndx < full.destinations().size(); ndx++) {
+      auto probability = 0.0;
+      if (index < distribution.destinations().size()
+          && distribution.destinations()[index] == full.destinations()[ndx]) {
+        probability = distribution.probability(index++);
+      }
+      distance += std::fabs(probability - full.probability(ndx));
+    }
+    REQUIRE(distance / 2 <= truncated);
+  }
+
+  // Nothing is dropped if there is no truncation
+  MovementDistribution distribution;
+  distribution.assign(weights, 0.0);
+  REQUIRE(distribution.destinations() == full.destinations());
+}
+
+TEST_CASE("Movement distribution benchmark", "[!benchmark]") {
+  // Gravity kernel for the center of a 250 x 200 raster (50k cells)
+  const auto rows = 250, cols = 200;
+  std::vector<double> weights(rows * cols);
+  for (auto row = 0; row < rows; row++) {
+    for (auto col = 0; col < cols; col++) {
+      const auto distance = 5 * std::hypot(row - rows / 2, col - cols / 2);
+      weights[row * cols + col] = std::pow(1 + distance / 12.6, -1.0);
+    }
+  }
+  MovementDistribution distribution;
+  distribution.assign(weights);
+
+  Random random;
+  random.initialize(42);
+  const auto travellers = 8u;
+  std::vector<unsigned int> counts(weights.size());
+  std::vector<double> uniforms(travellers);
+  std::vector<int> destinations(travellers);
+
+  BENCHMARK("multinomial over all cells") {
+    random.random_multinomial(weights.size(), travellers, weights.data(),
+                              counts.data());
+    auto moves = 0;
+    for (auto count : counts) {
+      if (count != 0) { moves++; }
+    }
+    return moves;
+  };
+
+  BENCHMARK("sample each traveller") {
+    random.fill_uniform(uniforms.data(), uniforms.size());
+    for (std::size_t ndx = 0; ndx < travellers; ndx++) {
+      destinations[ndx] = distribution.sample(uniforms[ndx]);
+    }
+    std::sort(destinations.begin(), destinations.end());
+    return destinations.back();
+  };
+}
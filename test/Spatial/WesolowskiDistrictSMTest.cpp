@@ -0,0 +1,102 @@
+#include "Spatial/WesolowskiDistrictSM.hxx"
+
+#include <cmath>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Spatial/WesolowskiSurfaceSM.hxx"
+#include "yaml-cpp/yaml.h"
+
+using namespace Spatial;
+
+namespace {
+// A raster of 12 x 12 cells divided into 16 zero-based districts of 3 x 3
+// cells, with the population and travel time varying across the raster
+struct Raster {
+  std::vector<Location> locations;
+  IntVector districts;
+  DoubleVector travel;
+  IntVector residents;
+};
+
+Raster make_raster() {
+  Raster raster;
+  const auto size = 12;
+  for (auto row = 0; row < size; row++) {
+    for (auto col = 0; col < size; col++) {
+      const auto id = row * size + col;
+      raster.locations.emplace_back(id, static_cast<float>(row),
+                                    static_cast<float>(col), 0);
+      raster.districts.push_back((row / 3) * 4 + col / 3);
+      raster.travel.push_back(0.1 * ((row + col) % 4));
+      raster.residents.push_back(100 + 25 * col + 10 * (row % 3));
+    }
+  }
+  return raster;
+}
+
+YAML::Node make_node() {
+  YAML::Node node;
+  node["kappa"] = 1.0;
+  node["alpha"] = 1.0;
+  node["beta"] = 1.0;
+  node["gamma"] = 1.0;
+  return node;
+}
+}  // namespace
+
+TEST_CASE("Two-stage movement is close to the flat model", "[Spatial]") {
+  const auto raster = make_raster();
+  const auto locations = static_cast<int>(raster.locations.size());
+  const auto distances = DistanceMatrix::from_raster(raster.locations, 1);
+
+  WesolowskiDistrictSM model(make_node());
+  model.prepare(raster.districts, raster.travel, raster.locations, distances);
+  model.update_residents_by_location(raster.residents);
+
+  WesolowskiSurfaceSM flat(make_node());
+  flat.prepare(raster.travel);
+
+  auto mean_distance = 0.0;
+  for (auto source = 0; source < locations; source++) {
+    const auto actual = model.get_v_relative_out_movement_to_destination(
+        source, locations, distances, raster.residents);
+    const auto expected = flat.get_v_relative_out_movement_to_destination(
+        source, locations, distances, raster.residents);
+    auto total = 0.0;
+    for (auto value : expected) { total += value; }
+
+    auto sum = 0.0;
+    auto distance = 0.0;
+    for (auto location = 0; location < locations; location++) {
+      sum += actual[location];
+      distance += std::fabs(actual[location] - expected[location] / total);
+    }
+    REQUIRE(std::fabs(sum - 1) < 1e-9);
+    REQUIRE(actual[source] == 0);
+
+    // Total variation distance from the flat model for this source
+    REQUIRE(distance / 2 < 0.2);
+    mean_distance += distance / 2;
+  }
+  REQUIRE(mean_distance / locations < 0.15);
+}
+
+TEST_CASE("Two-stage movement never returns the source cell", "[Spatial]") {
+  const auto raster = make_raster();
+  const auto locations = static_cast<int>(raster.locations.size());
+  const auto distances = DistanceMatrix::from_raster(raster.locations, 1);
+
+  WesolowskiDistrictSM model(make_node());
+  model.prepare(raster.districts, raster.travel, raster.locations, distances);
+  model.update_residents_by_location(raster.residents);
+
+  for (auto source = 0; source < locations; source++) {
+    for (auto ndx = 0; ndx < 1000; ndx++) {
+      const auto destination = model.sample_destination(source, ndx / 1000.0);
+      REQUIRE(destination >= 0);
+      REQUIRE(destination < locations);
+      REQUIRE(destination != source);
+    }
+  }
+}
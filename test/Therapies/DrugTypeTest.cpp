@@ -0,0 +1,61 @@
+#include "Therapies/DrugType.h"
+
+#include <cmath>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Decay table matches the exact pharmacokinetic decay",
+          "[drug type]") {
+  DrugType dt;
+  dt.set_drug_half_life(4.5);
+  dt.build_decay_table();
+
+  // The drug is active until it decays to 10% of the starting value
+  const auto duration = dt.get_total_duration_of_drug_activity(0);
+  for (auto day = 0; day <= duration + 10; day++) {
+    const auto exact = exp(-day * log(2) / dt.drug_half_life());
+    const auto expected = (exact <= 0.1) ? 0.0 : exact;
+    REQUIRE(dt.get_decay_factor(day) == expected);
+  }
+}
+
+TEST_CASE("Decay table for a drug without a half-life", "[drug type]") {
+  DrugType dt;
+  dt.set_drug_half_life(0);
+  dt.build_decay_table();
+
+  REQUIRE(dt.get_decay_factor(1) == 0.0);
+}
+
+TEST_CASE("Killing rate table is within tolerance of the Hill function",
+          "[drug type]") {
+  DrugType dt;
+  dt.set_maximum_parasite_killing_rate(0.999);
+
+  // Three genotypes, two of which share an EC50
+  const DoubleVector ec50 = {0.75, 0.75, 1.2};
+
+  for (auto n : {1.0, 4.0, 25.0}) {
+    dt.set_n(n);
+    DoubleVector2 EC50_power_n_table;
+    for (auto value : ec50) { EC50_power_n_table.push_back({pow(value, n)}); }
+    dt.build_killing_rate_tables(EC50_power_n_table);
+
+    REQUIRE(dt.killing_rate_table_error()
+            <= DrugType::KILLING_RATE_TABLE_TOLERANCE);
+
+    // Check off of the grid, including concentrations beyond the table
+    for (auto concentration = 0.0; concentration < 5.0;
+         concentration += 0.000731) {
+      for (std::size_t genotype_id = 0; genotype_id < ec50.size();
+           genotype_id++) {
+        const auto exact = dt.get_parasite_killing_rate_by_concentration(
+            concentration, EC50_power_n_table[genotype_id][0]);
+        const auto table = dt.get_parasite_killing_rate(
+            concentration, static_cast<int>(genotype_id));
+        REQUIRE(std::fabs(exact - table)
+                <= DrugType::KILLING_RATE_TABLE_TOLERANCE);
+      }
+    }
+  }
+}